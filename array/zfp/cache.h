@@ -2,6 +2,8 @@
 #define ZFP_CACHE_H
 
 #include "memory.h"
+#include "mutex.h"
+#include "exception.h"
 
 #ifdef ZFP_WITH_CACHE_PROFILE
   // maintain stats on hit and miss rates
@@ -9,9 +11,17 @@
 #endif
 
 namespace zfp {
+
+// replacement policy within sets of a set-associative cache
+enum cache_policy {
+  cache_lru = 0,  // evict least recently used line
+  cache_clock = 1 // evict first line not referenced since last sweep
+};
+
 namespace internal {
 
-// direct-mapped or two-way skew-associative write-back cache
+// direct-mapped, two-way skew-associative, or N-way set-associative
+// write-back cache
 template <class Line>
 class Cache {
 public:
@@ -87,8 +97,48 @@ public:
     Pair pair;
   };
 
+  // scoped lock on the cache lines that may hold line #x; a no-op unless the
+  // cache is concurrent
+  class Guard {
+  public:
+    Guard(const Cache& cache, Index x) : c(cache), x(x) { c.lock(x); }
+    ~Guard() { c.unlock(x); }
+
+  protected:
+    const Cache& c;
+    Index x;
+  };
+
+  // scoped enabling of locking while OpenMP threads spawned by the owner of
+  // the cache access it concurrently
+  class ConcurrentScope {
+  public:
+    ConcurrentScope(Cache& cache) : c(cache), concurrent(cache.concurrent())
+    {
+#ifdef _OPENMP
+      c.set_concurrent(true);
+#endif
+    }
+    ~ConcurrentScope() { c.set_concurrent(concurrent); }
+
+  protected:
+    Cache& c;
+    bool concurrent;
+  };
+
   // allocate cache with at least minsize lines
-  Cache(uint minsize = 0) : mask(0), tag(0), line(0)
+  Cache(uint minsize = 0) :
+    mask(0),
+    ways(1),
+    shift(0),
+    policy(cache_lru),
+    tag(0),
+    line(0),
+    state(0),
+    hand(0),
+    locks(0),
+    hits(0),
+    misses(0)
   {
     resize(minsize);
 #ifdef ZFP_WITH_CACHE_PROFILE
@@ -99,7 +149,14 @@ public:
   }
 
   // copy constructor--performs a deep copy
-  Cache(const Cache& c) : tag(0), line(0)
+  Cache(const Cache& c) :
+    tag(0),
+    line(0),
+    state(0),
+    hand(0),
+    locks(0),
+    hits(0),
+    misses(0)
   {
     deep_copy(c);
   }
@@ -109,6 +166,9 @@ public:
   {
     zfp::deallocate_aligned(tag);
     zfp::deallocate_aligned(line);
+    zfp::deallocate_aligned(state);
+    zfp::deallocate_aligned(hand);
+    delete[] locks;
 #ifdef ZFP_WITH_CACHE_PROFILE
     std::cerr << "cache R1=" << hit[0][0] << " R2=" << hit[1][0] << " RM=" << miss[0] << " RB=" << back[0]
               <<      " W1=" << hit[0][1] << " W2=" << hit[1][1] << " WM=" << miss[1] << " WB=" << back[1] << std::endl;
@@ -127,16 +187,28 @@ public:
   size_t size_bytes(uint mask = ZFP_DATA_ALL) const
   {
     size_t size = 0;
-    if (mask & ZFP_DATA_CACHE)
+    if (mask & ZFP_DATA_CACHE) {
       size += this->size() * (sizeof(*tag) + sizeof(*line));
-    if (mask & ZFP_DATA_META)
+      if (state)
+        size += this->size() * sizeof(*state) + sets() * sizeof(*hand);
+    }
+    if (mask & ZFP_DATA_META) {
       size += sizeof(*this);
+      if (locks)
+        size += stripes * sizeof(*locks);
+    }
     return size;
   }
 
   // cache size in number of lines
   uint size() const { return mask + 1; }
 
+  // number of lines per set (one if direct mapped)
+  uint associativity() const { return 1u << shift; }
+
+  // replacement policy within sets
+  cache_policy replacement() const { return policy; }
+
   // change cache size to at least minsize lines (all contents will be lost)
   void resize(uint minsize)
   {
@@ -144,13 +216,61 @@ public:
     for (mask = minsize ? minsize - 1 : 1; mask & (mask + 1); mask |= mask + 1);
     zfp::reallocate_aligned(tag, size() * sizeof(Tag), ZFP_MEMORY_ALIGNMENT);
     zfp::reallocate_aligned(line, size() * sizeof(Line), ZFP_MEMORY_ALIGNMENT);
-    clear();
+    configure();
+  }
+
+  // change number of lines per set to at least minways (rounded up to a power
+  // of two no larger than the cache size) and the replacement policy within
+  // sets (all contents will be lost)
+  void set_associativity(uint minways, cache_policy policy)
+  {
+    // compute smallest power of two ways >= minways
+    for (ways = 1; ways < minways; ways *= 2);
+    this->policy = policy;
+    configure();
+  }
+
+  // fraction of accesses since last resize that hit in the cache
+  double hit_ratio() const
+  {
+    uint64 h, m;
+    totals(h, m);
+    return h + m ? double(h) / double(h + m) : 0.0;
+  }
+
+  // is cache safe to access from concurrent threads?
+  bool concurrent() const { return locks != 0; }
+
+  // enable or disable locking of cache lines for access by concurrent threads;
+  // throws an exception if no lock implementation is available
+  void set_concurrent(bool concurrent)
+  {
+    if (concurrent && !Mutex::supported())
+      throw zfp::exception("zfp cache locking not supported on this platform");
+    if (concurrent != this->concurrent()) {
+      totals(hits, misses);
+      delete[] locks;
+      locks = concurrent ? new Lock[stripes] : 0;
+    }
   }
 
   // look up cache line #x and return pointer to it if in the cache;
   // otherwise return null
   Line* lookup(Index x, bool write)
   {
+    if (shift) {
+      uint s = base(x);
+      for (uint w = 0; w < associativity(); w++) {
+        uint i = s + w;
+        if (tag[i].index() == x) {
+          if (write)
+            tag[i].mark();
+          touch(s, w);
+          return line + i;
+        }
+      }
+      return 0;
+    }
     uint i = primary(x);
     if (tag[i].index() == x) {
       if (write)
@@ -161,7 +281,7 @@ public:
     uint j = secondary(x);
     if (tag[j].index() == x) {
       if (write)
-        tag[i].mark();
+        tag[j].mark();
       return line + j;
     }
 #endif
@@ -173,11 +293,14 @@ public:
   // write-back (if the line is in use) and then fetch the requested line
   Tag access(Line*& ptr, Index x, bool write)
   {
+    if (shift)
+      return access_set(ptr, x, write);
     uint i = primary(x);
     if (tag[i].index() == x) {
       ptr = line + i;
       if (write)
         tag[i].mark();
+      count(x, true);
 #ifdef ZFP_WITH_CACHE_PROFILE
       hit[0][write]++;
 #endif
@@ -189,6 +312,7 @@ public:
       ptr = line + j;
       if (write)
         tag[j].mark();
+      count(x, true);
 #ifdef ZFP_WITH_CACHE_PROFILE
       hit[1][write]++;
 #endif
@@ -200,6 +324,7 @@ public:
     ptr = line + i;
     Tag t = tag[i];
     tag[i] = Tag(x, write);
+    count(x, false);
 #ifdef ZFP_WITH_CACHE_PROFILE
     miss[write]++;
     if (tag[i].dirty())
@@ -213,6 +338,13 @@ public:
   {
     for (uint i = 0; i <= mask; i++)
       tag[i].clear();
+    // order lines in each set by recency and reset clock hands
+    if (state) {
+      for (uint i = 0; i <= mask; i++)
+        state[i] = policy == cache_lru ? i & (associativity() - 1) : 0;
+      for (uint s = 0; s < sets(); s++)
+        hand[s] = 0;
+    }
   }
 
   // flush cache line
@@ -226,12 +358,29 @@ public:
   const_iterator first() { return const_iterator(this); }
 
 protected:
+  // lock on stripe of cache lines and number of accesses made under it
+  class Lock {
+  public:
+    Lock() : hits(0), misses(0) {}
+    Mutex mutex;   // lock guarding stripe
+    uint64 hits;   // number of cache hits in stripe
+    uint64 misses; // number of cache misses in stripe
+  };
+
   // perform a deep copy
   void deep_copy(const Cache& c)
   {
+    set_concurrent(c.concurrent());
     mask = c.mask;
+    ways = c.ways;
+    shift = c.shift;
+    policy = c.policy;
     zfp::clone_aligned(tag, c.tag, size(), ZFP_MEMORY_ALIGNMENT);
     zfp::clone_aligned(line, c.line, size(), ZFP_MEMORY_ALIGNMENT);
+    zfp::clone_aligned(state, c.state, c.state ? size() : 0, ZFP_MEMORY_ALIGNMENT);
+    zfp::clone_aligned(hand, c.hand, c.hand ? sets() : 0, ZFP_MEMORY_ALIGNMENT);
+    reset_counts();
+    c.totals(hits, misses);
 #ifdef ZFP_WITH_CACHE_PROFILE
     hit[0][0] = c.hit[0][0];
     hit[0][1] = c.hit[0][1];
@@ -244,6 +393,183 @@ protected:
 #endif
   }
 
+  // total number of hits and misses across lock stripes
+  void totals(uint64& h, uint64& m) const
+  {
+    h = hits;
+    m = misses;
+    if (locks)
+      for (uint i = 0; i < stripes; i++) {
+        h += locks[i].hits;
+        m += locks[i].misses;
+      }
+  }
+
+  // set up sets and replacement state for current size and associativity
+  void configure()
+  {
+    // at most one set spans the whole cache
+    for (shift = 0; (1u << shift) < std::min(ways, size()); shift++);
+    if (shift) {
+      zfp::reallocate_aligned(state, size() * sizeof(*state), ZFP_MEMORY_ALIGNMENT);
+      zfp::reallocate_aligned(hand, sets() * sizeof(*hand), ZFP_MEMORY_ALIGNMENT);
+    }
+    else {
+      zfp::deallocate_aligned(state);
+      zfp::deallocate_aligned(hand);
+      state = 0;
+      hand = 0;
+    }
+    clear();
+    reset_counts();
+  }
+
+  // reset number of cache hits and misses
+  void reset_counts()
+  {
+    hits = misses = 0;
+    if (locks)
+      for (uint i = 0; i < stripes; i++)
+        locks[i].hits = locks[i].misses = 0;
+  }
+
+  // look up cache line #x in its set; on a miss, evict a line in the set
+  Tag access_set(Line*& ptr, Index x, bool write)
+  {
+    uint s = base(x);
+    uint w;
+    for (w = 0; w < associativity(); w++) {
+      uint i = s + w;
+      if (tag[i].index() == x) {
+        ptr = line + i;
+        if (write)
+          tag[i].mark();
+        touch(s, w);
+        count(x, true);
+#ifdef ZFP_WITH_CACHE_PROFILE
+        hit[0][write]++;
+#endif
+        return tag[i];
+      }
+    }
+    w = victim(s);
+    uint i = s + w;
+    ptr = line + i;
+    Tag t = tag[i];
+    tag[i] = Tag(x, write);
+    touch(s, w);
+    count(x, false);
+#ifdef ZFP_WITH_CACHE_PROFILE
+    miss[write]++;
+    if (t.dirty())
+      back[write]++;
+#endif
+    return t;
+  }
+
+  // record use of way w of set beginning with line s
+  void touch(uint s, uint w)
+  {
+    if (policy == cache_lru) {
+      // age lines more recently used than line w, which becomes the youngest
+      uint age = state[s + w];
+      for (uint v = 0; v < associativity(); v++)
+        if (state[s + v] < age)
+          state[s + v]++;
+      state[s + w] = 0;
+    }
+    else
+      state[s + w] = 1;
+  }
+
+  // way of set beginning with line s to evict, preferring unused lines
+  uint victim(uint s)
+  {
+    uint w;
+    for (w = 0; w < associativity(); w++)
+      if (!tag[s + w].used())
+        return w;
+    if (policy == cache_lru) {
+      // evict oldest line
+      for (w = 0; state[s + w] != associativity() - 1; w++);
+      return w;
+    }
+    else {
+      // advance clock hand past referenced lines, clearing their references
+      uint& h = hand[s >> shift];
+      while (state[s + h]) {
+        state[s + h] = 0;
+        h = (h + 1) & (associativity() - 1);
+      }
+      w = h;
+      h = (h + 1) & (associativity() - 1);
+      return w;
+    }
+  }
+
+  // record cache hit or miss on line #x
+  void count(Index x, bool hit)
+  {
+    if (locks) {
+      Lock& l = locks[stripe(group(x))];
+      if (hit)
+        l.hits++;
+      else
+        l.misses++;
+    }
+    else if (hit)
+      hits++;
+    else
+      misses++;
+  }
+
+  // acquire locks guarding cache line #x
+  void lock(Index x) const
+  {
+    if (locks) {
+      uint i = stripe(group(x));
+#ifdef ZFP_WITH_CACHE_TWOWAY
+      if (!shift) {
+        // acquire both stripes in ascending order to avoid deadlock
+        uint j = stripe(secondary(x));
+        if (i != j)
+          locks[std::min(i, j)].mutex.acquire();
+        i = std::max(i, j);
+      }
+#endif
+      locks[i].mutex.acquire();
+    }
+  }
+
+  // release locks acquired by lock(x)
+  void unlock(Index x) const
+  {
+    if (locks) {
+      uint i = stripe(group(x));
+#ifdef ZFP_WITH_CACHE_TWOWAY
+      if (!shift) {
+        uint j = stripe(secondary(x));
+        if (i != j)
+          locks[std::min(i, j)].mutex.release();
+        i = std::max(i, j);
+      }
+#endif
+      locks[i].mutex.release();
+    }
+  }
+
+  // lock stripe guarding set (or line if direct mapped) g
+  static uint stripe(uint g) { return g & (stripes - 1); }
+
+  // number of sets
+  uint sets() const { return size() >> shift; }
+
+  // set that line #x maps to (or line if direct mapped)
+  uint group(Index x) const { return x & (mask >> shift); }
+
+  // first line of set that line #x maps to
+  uint base(Index x) const { return group(x) << shift; }
+
   uint primary(Index x) const { return x & mask; }
   uint secondary(Index x) const
   {
@@ -265,9 +591,19 @@ protected:
     return x & mask;
   }
 
-  Index mask; // cache line mask
-  Tag* tag;   // cache line tags
-  Line* line; // actual decompressed cache lines
+  static const uint stripes = 64; // number of lock stripes (a power of two)
+
+  Index mask;          // cache line mask
+  uint ways;           // requested number of lines per set
+  uint shift;          // base-two logarithm of number of lines per set
+  cache_policy policy; // replacement policy within sets
+  Tag* tag;            // cache line tags
+  Line* line;          // actual decompressed cache lines
+  uint* state;         // per-line LRU age or CLOCK reference bit (null if direct mapped)
+  uint* hand;          // per-set CLOCK hand (null if direct mapped)
+  Lock* locks;         // lock stripes (null unless concurrent)
+  uint64 hits;         // number of cache hits outside lock stripes
+  uint64 misses;       // number of cache misses outside lock stripes
 #ifdef ZFP_WITH_CACHE_PROFILE
   uint64 hit[2][2]; // number of primary/secondary read/write hits
   uint64 miss[2];   // number of read/write misses
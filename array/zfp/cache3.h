@@ -1,6 +1,7 @@
 #ifndef ZFP_CACHE3_H
 #define ZFP_CACHE3_H
 
+#include <algorithm>
 #include "cache.h"
 
 namespace zfp {
@@ -35,19 +36,53 @@ public:
     cache.resize(lines(bytes, store.blocks()));
   }
 
+  // number of cache lines per set (one if direct mapped)
+  uint associativity() const { return cache.associativity(); }
+
+  // replacement policy within sets
+  zfp::cache_policy replacement() const { return cache.replacement(); }
+
+  // set minimum number of cache lines per set and replacement policy
+  void set_associativity(uint ways, zfp::cache_policy policy)
+  {
+    flush();
+    cache.set_associativity(ways, policy);
+  }
+
+  // fraction of accesses since last reconfiguration that hit in the cache
+  double hit_ratio() const { return cache.hit_ratio(); }
+
+  // is cache safe to access from concurrent threads?
+  bool concurrent() const { return cache.concurrent(); }
+
+  // enable or disable locking for access by concurrent threads
+  void set_concurrent(bool concurrent) { cache.set_concurrent(concurrent); }
+
   // empty cache without compressing modified cached blocks
   void clear() const { cache.clear(); }
 
   // flush cache by compressing all modified cached blocks
   void flush() const
   {
+    // gather modified cached blocks; flushed lines retain their data
+    size_t* index = new size_t[cache.size()];
+    const CacheLine** cached = new const CacheLine*[cache.size()];
+    size_t n = 0;
     for (typename zfp::internal::Cache<CacheLine>::const_iterator p = cache.first(); p; p++) {
       if (p->tag.dirty()) {
-        size_t block_index = p->tag.index() - 1;
-        store.encode(block_index, p->line->data());
+        index[n] = p->tag.index() - 1;
+        cached[n++] = p->line;
       }
       cache.flush(p->line);
     }
+    // compress blocks, concurrently when the store permits
+    if (store.concurrent_encode())
+      store.for_each(n, LineEncoder(*this, index, cached));
+    else
+      for (size_t i = 0; i < n; i++)
+        store.encode(index[i], cached[i]->data());
+    delete[] cached;
+    delete[] index;
   }
 
   // perform a deep copy
@@ -56,27 +91,34 @@ public:
   // inspector
   Scalar get(size_t i, size_t j, size_t k) const
   {
-    const CacheLine* p = line(i, j, k, false);
+    size_t block_index = store.block_index(i, j, k);
+    Guard line_guard(cache, (uint)block_index + 1);
+    const CacheLine* p = line(block_index, false);
     return (*p)(i, j, k);
   }
 
   // mutator
   void set(size_t i, size_t j, size_t k, Scalar val)
   {
-    CacheLine* p = line(i, j, k, true);
+    size_t block_index = store.block_index(i, j, k);
+    Guard line_guard(cache, (uint)block_index + 1);
+    CacheLine* p = line(block_index, true);
     (*p)(i, j, k) = val;
   }
 
-  // reference to cached element
+  // reference to cached element (the referenced line is not locked)
   Scalar& ref(size_t i, size_t j, size_t k)
   {
-    CacheLine* p = line(i, j, k, true);
+    size_t block_index = store.block_index(i, j, k);
+    Guard line_guard(cache, (uint)block_index + 1);
+    CacheLine* p = line(block_index, true);
     return (*p)(i, j, k);
   }
 
   // read-no-allocate: copy block from cache on hit, else from store without caching
   void get_block(size_t block_index, Scalar* p, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz) const
   {
+    Guard line_guard(cache, (uint)block_index + 1);
     const CacheLine* line = cache.lookup((uint)block_index + 1, false);
     if (line)
       line->get(p, sx, sy, sz, store.block_shape(block_index));
@@ -87,6 +129,7 @@ public:
   // write-no-allocate: copy block to cache on hit, else to store without caching
   void put_block(size_t block_index, const Scalar* p, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz) const
   {
+    Guard line_guard(cache, (uint)block_index + 1);
     CacheLine* line = cache.lookup((uint)block_index + 1, true);
     if (line)
       line->put(p, sx, sy, sz, store.block_shape(block_index));
@@ -94,6 +137,45 @@ public:
       store.encode(block_index, p, sx, sy, sz);
   }
 
+  // copy all blocks to strided array, from cache for cached blocks and
+  // otherwise by decoding blocks concurrently
+  void get_blocks(Scalar* p, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz) const
+  {
+    typename zfp::internal::Cache<CacheLine>::ConcurrentScope scope(cache);
+    store.for_each(store.blocks(), BlockGetter(*this, p, sx, sy, sz));
+  }
+
+  // copy all blocks from strided array (zeros if p is null) to cache for
+  // cached blocks and encode them concurrently; store must have been cleared
+  // unless it permits concurrent encoding
+  void put_blocks(const Scalar* p, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz) const
+  {
+    const Scalar zero[4 * 4 * 4] = {};
+    typename zfp::internal::Cache<CacheLine>::ConcurrentScope scope(cache);
+    if (p)
+      store.encode_all(BlockPutter(*this, p, sx, sy, sz, 4 * sx, 4 * sy, 4 * sz));
+    else
+      store.encode_all(BlockPutter(*this, zero, 1, 4, 16, 0, 0, 0));
+  }
+
+  // decode blocks overlapping region of ni*nj*nk elements with origin (i0, j0,
+  // k0) ahead of use, decoding fewer blocks than there are cache lines; blocks
+  // are decoded concurrently when the cache is not shared
+  void prefetch(size_t i0, size_t j0, size_t k0, size_t ni, size_t nj, size_t nk) const
+  {
+    if (!ni || !nj || !nk)
+      return;
+    size_t count = cache.size() - 1;
+    size_t* index = new size_t[count];
+    size_t n = 0;
+    for (size_t k = k0 & ~size_t(3); k < k0 + nk && n < count; k += 4)
+      for (size_t j = j0 & ~size_t(3); j < j0 + nj && n < count; j += 4)
+        for (size_t i = i0 & ~size_t(3); i < i0 + ni && n < count; i += 4)
+          index[n++] = store.block_index(i, j, k);
+    fetch(index, n);
+    delete[] index;
+  }
+
 protected:
   // cache line representing one block of decompressed values
   class CacheLine {
@@ -167,11 +249,103 @@ protected:
     Scalar a[4 * 4 * 4];
   };
 
-  // return cache line for (i, j, k); may require write-back and fetch
-  CacheLine* line(size_t i, size_t j, size_t k, bool write) const
+  // scoped lock on cache lines (see Cache::Guard)
+  typedef typename zfp::internal::Cache<CacheLine>::Guard Guard;
+
+  // functor for copying block to strided array with origin p
+  class BlockGetter {
+  public:
+    BlockGetter(const BlockCache3& c, Scalar* p, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz) : c(c), p(p), sx(sx), sy(sy), sz(sz) {}
+
+    template <class Codec>
+    void operator()(const Codec& codec, size_t block_index) const
+    {
+      Scalar* q = p + c.block_offset(block_index, 4 * sx, 4 * sy, 4 * sz);
+      Guard line_guard(c.cache, (uint)block_index + 1);
+      const CacheLine* line = c.cache.lookup((uint)block_index + 1, false);
+      if (line)
+        line->get(q, sx, sy, sz, c.store.block_shape(block_index));
+      else
+        c.store.decode(codec, block_index, q, sx, sy, sz);
+    }
+
+  protected:
+    const BlockCache3& c;
+    Scalar* p;
+    ptrdiff_t sx, sy, sz;
+  };
+
+  // functor for encoding block from strided array with origin p and block
+  // strides (ox, oy, oz), which also updates the block if cached
+  class BlockPutter {
+  public:
+    BlockPutter(const BlockCache3& c, const Scalar* p, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz, ptrdiff_t ox, ptrdiff_t oy, ptrdiff_t oz) : c(c), p(p), sx(sx), sy(sy), sz(sz), ox(ox), oy(oy), oz(oz) {}
+
+    template <class Codec>
+    size_t operator()(const Codec& codec, size_t offset, size_t block_index) const
+    {
+      const Scalar* q = p + c.block_offset(block_index, ox, oy, oz);
+      Guard line_guard(c.cache, (uint)block_index + 1);
+      CacheLine* line = c.cache.lookup((uint)block_index + 1, false);
+      if (line)
+        line->put(q, sx, sy, sz, c.store.block_shape(block_index));
+      return c.store.encode(codec, offset, block_index, q, sx, sy, sz);
+    }
+
+  protected:
+    const BlockCache3& c;
+    const Scalar* p;
+    ptrdiff_t sx, sy, sz;
+    ptrdiff_t ox, oy, oz;
+  };
+
+  // functor for encoding modified cached block #i
+  class LineEncoder {
+  public:
+    LineEncoder(const BlockCache3& c, const size_t* index, const CacheLine* const* cached) : c(c), index(index), cached(cached) {}
+
+    template <class Codec>
+    void operator()(const Codec& codec, size_t i) const
+    {
+      c.store.encode(codec, c.store.offset(index[i]), index[i], cached[i]->data());
+    }
+
+  protected:
+    const BlockCache3& c;
+    const size_t* index;
+    const CacheLine* const* cached;
+  };
+
+  // functor for decoding block #index[i] into its claimed cache line
+  class LineDecoder {
+  public:
+    LineDecoder(const BlockCache3& c, const size_t* index, CacheLine* const* fetched) : c(c), index(index), fetched(fetched) {}
+
+    template <class Codec>
+    void operator()(const Codec& codec, size_t i) const
+    {
+      c.store.decode(codec, index[i], fetched[i]->data(), 1, 4, 16);
+    }
+
+  protected:
+    const BlockCache3& c;
+    const size_t* index;
+    CacheLine* const* fetched;
+  };
+
+  // offset to block in strided array with given block strides
+  ptrdiff_t block_offset(size_t block_index, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz) const
+  {
+    size_t i = block_index % store.block_size_x(); block_index /= store.block_size_x();
+    size_t j = block_index % store.block_size_y(); block_index /= store.block_size_y();
+    size_t k = block_index;
+    return static_cast<ptrdiff_t>(i) * sx + static_cast<ptrdiff_t>(j) * sy + static_cast<ptrdiff_t>(k) * sz;
+  }
+
+  // return cache line for block; may require write-back and fetch
+  CacheLine* line(size_t block_index, bool write) const
   {
     CacheLine* p = 0;
-    size_t block_index = store.block_index(i, j, k);
     typename zfp::internal::Cache<CacheLine>::Tag tag = cache.access(p, (uint)block_index + 1, write);
     size_t stored_block_index = tag.index() - 1;
     if (stored_block_index != block_index) {
@@ -184,6 +358,48 @@ protected:
     return p;
   }
 
+  // fetch uncached blocks with given increasing indices by first claiming
+  // their cache lines and then decoding them concurrently
+  void fetch(const size_t* index, size_t n) const
+  {
+    // shared lines must remain locked while decoded
+    if (cache.concurrent()) {
+      for (size_t i = 0; i < n; i++) {
+        Guard line_guard(cache, (uint)index[i] + 1);
+        // count only blocks actually decoded as cache misses
+        if (!cache.lookup((uint)index[i] + 1, false))
+          line(index[i], false);
+      }
+      return;
+    }
+    size_t* fetched_index = new size_t[n];
+    CacheLine** fetched = new CacheLine*[n];
+    size_t m = 0;
+    for (size_t i = 0; i < n; i++) {
+      // count only blocks actually decoded as cache misses
+      if (cache.lookup((uint)index[i] + 1, false))
+        continue;
+      CacheLine* p = 0;
+      typename zfp::internal::Cache<CacheLine>::Tag tag = cache.access(p, (uint)index[i] + 1, false);
+      size_t stored_block_index = tag.index() - 1;
+      size_t* q = std::lower_bound(fetched_index, fetched_index + m, stored_block_index);
+      if (q != fetched_index + m && *q == stored_block_index) {
+        // line was claimed earlier in this batch; abandon that block
+        size_t j = static_cast<size_t>(q - fetched_index);
+        std::copy(fetched_index + j + 1, fetched_index + m, fetched_index + j);
+        std::copy(fetched + j + 1, fetched + m, fetched + j);
+        m--;
+      }
+      else if (tag.dirty())
+        store.encode(stored_block_index, p->data());
+      fetched_index[m] = index[i];
+      fetched[m++] = p;
+    }
+    store.for_each(m, LineDecoder(*this, fetched_index, fetched));
+    delete[] fetched;
+    delete[] fetched_index;
+  }
+
   // default number of cache lines for array with given number of blocks
   static uint lines(size_t blocks)
   {
@@ -23,8 +23,8 @@ public:
   // default constructor
   const_iterator() : const_handle<Container>(0, 0) {}
 
-  // constructor
-  explicit const_iterator(const container_type* container, size_t x) : const_handle<Container>(container, x) {}
+  // constructor, which prefetches the first batch of blocks visited
+  explicit const_iterator(const container_type* container, size_t x) : const_handle<Container>(container, x) { if (container) prefetch(); }
 
   // dereference iterator
   const_reference operator*() const { return const_reference(container, x); }
@@ -67,11 +67,28 @@ protected:
   void advance(difference_type d) { index(x, offset(d)); }
 
   // increment iterator to next element
-  void increment() { ++x; }
+  void increment()
+  {
+    ++x;
+    if (!(x % (4 * prefetch_blocks)))
+      prefetch();
+  }
 
   // decrement iterator to previous element
   void decrement() { --x; }
 
+  // prefetch batch of blocks upon entering its first block
+  void prefetch() const
+  {
+    size_t xmin = container->min_x();
+    size_t xmax = container->max_x();
+    size_t n = 4 * prefetch_blocks;
+    if (x < xmax && (x == xmin || !(x % n)))
+      container->prefetch(x - xmin, std::min(x - x % n + n, xmax) - x);
+  }
+
+  static const size_t prefetch_blocks = 8; // number of blocks per prefetch batch
+
   using const_handle<Container>::container;
   using const_handle<Container>::x;
 };
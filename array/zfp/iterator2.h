@@ -23,8 +23,8 @@ public:
   // default constructor
   const_iterator() : const_handle<Container>(0, 0, 0) {}
 
-  // constructor
-  explicit const_iterator(const container_type* container, size_t x, size_t y) : const_handle<Container>(container, x, y) {}
+  // constructor, which prefetches the first batch of blocks visited
+  explicit const_iterator(const container_type* container, size_t x, size_t y) : const_handle<Container>(container, x, y) { if (container) prefetch(); }
 
   // dereference iterator
   const_reference operator*() const { return const_reference(container, x, y); }
@@ -127,6 +127,7 @@ protected:
           if (y >= ymax)
             y = ymax;
         }
+        prefetch();
       }
     }
   }
@@ -163,6 +164,24 @@ protected:
     }
   }
 
+  // prefetch batch of blocks along x upon entering its first block
+  void prefetch() const
+  {
+    size_t xmin = container->min_x();
+    size_t xmax = container->max_x();
+    size_t ymin = container->min_y();
+    size_t ymax = container->max_y();
+    size_t m = ~size_t(3);
+    size_t n = 4 * prefetch_blocks;
+    if (y < ymax && (x == xmin || !(x % n))) {
+      size_t sx = std::min(x - x % n + n, xmax) - x;
+      size_t sy = std::min((y + 4) & m, ymax) - y;
+      container->prefetch(x - xmin, y - ymin, sx, sy);
+    }
+  }
+
+  static const size_t prefetch_blocks = 8; // number of blocks per prefetch batch
+
   using const_handle<Container>::container;
   using const_handle<Container>::x;
   using const_handle<Container>::y;
@@ -23,8 +23,8 @@ public:
   // default constructor
   const_iterator() : const_handle<Container>(0, 0, 0, 0, 0) {}
 
-  // constructor
-  explicit const_iterator(const container_type* container, size_t x, size_t y, size_t z, size_t w) : const_handle<Container>(container, x, y, z, w) {}
+  // constructor, which prefetches the first batch of blocks visited
+  explicit const_iterator(const container_type* container, size_t x, size_t y, size_t z, size_t w) : const_handle<Container>(container, x, y, z, w) { if (container) prefetch(); }
 
   // dereference iterator
   const_reference operator*() const { return const_reference(container, x, y, z, w); }
@@ -169,6 +169,7 @@ protected:
                 }
               }
             }
+            prefetch();
           }
         }
       }
@@ -229,6 +230,30 @@ protected:
     }
   }
 
+  // prefetch batch of blocks along x upon entering its first block
+  void prefetch() const
+  {
+    size_t xmin = container->min_x();
+    size_t xmax = container->max_x();
+    size_t ymin = container->min_y();
+    size_t ymax = container->max_y();
+    size_t zmin = container->min_z();
+    size_t zmax = container->max_z();
+    size_t wmin = container->min_w();
+    size_t wmax = container->max_w();
+    size_t m = ~size_t(3);
+    size_t n = 4 * prefetch_blocks;
+    if (w < wmax && (x == xmin || !(x % n))) {
+      size_t sx = std::min(x - x % n + n, xmax) - x;
+      size_t sy = std::min((y + 4) & m, ymax) - y;
+      size_t sz = std::min((z + 4) & m, zmax) - z;
+      size_t sw = std::min((w + 4) & m, wmax) - w;
+      container->prefetch(x - xmin, y - ymin, z - zmin, w - wmin, sx, sy, sz, sw);
+    }
+  }
+
+  static const size_t prefetch_blocks = 8; // number of blocks per prefetch batch
+
   using const_handle<Container>::container;
   using const_handle<Container>::x;
   using const_handle<Container>::y;
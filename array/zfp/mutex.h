@@ -0,0 +1,81 @@
+#ifndef ZFP_MUTEX_H
+#define ZFP_MUTEX_H
+
+// Mutual exclusion based on POSIX threads or, on other platforms, the C++11
+// thread support library.  Without either, no lock is available.  The choice
+// deliberately does not depend on OpenMP so that translation units compiled
+// with and without OpenMP agree on the lock type.
+
+#if defined(__unix__) || defined(__APPLE__)
+  #include <pthread.h>
+  #define ZFP_MUTEX_PTHREAD
+#elif (defined(__cplusplus) && __cplusplus >= 201103L) || (defined(_MSVC_LANG) && _MSVC_LANG >= 201103L)
+  #include <mutex>
+  #define ZFP_MUTEX_STD
+#endif
+
+namespace zfp {
+namespace internal {
+
+class Mutex {
+public:
+  // is a lock implementation available?
+#if defined(ZFP_MUTEX_PTHREAD) || defined(ZFP_MUTEX_STD)
+  static bool supported() { return true; }
+#else
+  static bool supported() { return false; }
+#endif
+
+  Mutex()
+  {
+#if defined(ZFP_MUTEX_PTHREAD)
+    pthread_mutex_init(&lock, 0);
+#endif
+  }
+
+  ~Mutex()
+  {
+#if defined(ZFP_MUTEX_PTHREAD)
+    pthread_mutex_destroy(&lock);
+#endif
+  }
+
+  // acquire lock, blocking until it is available
+  void acquire()
+  {
+#if defined(ZFP_MUTEX_PTHREAD)
+    pthread_mutex_lock(&lock);
+#elif defined(ZFP_MUTEX_STD)
+    lock.lock();
+#endif
+  }
+
+  // release lock held by calling thread
+  void release()
+  {
+#if defined(ZFP_MUTEX_PTHREAD)
+    pthread_mutex_unlock(&lock);
+#elif defined(ZFP_MUTEX_STD)
+    lock.unlock();
+#endif
+  }
+
+private:
+  // locks are not copyable
+  Mutex(const Mutex&);
+  Mutex& operator=(const Mutex&);
+
+#if defined(ZFP_MUTEX_PTHREAD)
+  pthread_mutex_t lock;
+#elif defined(ZFP_MUTEX_STD)
+  std::mutex lock;
+#endif
+};
+
+} // internal
+} // zfp
+
+#undef ZFP_MUTEX_PTHREAD
+#undef ZFP_MUTEX_STD
+
+#endif
@@ -4,11 +4,16 @@
 #include <climits>
 #include <cmath>
 #include "zfp/memory.h"
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
 
 namespace zfp {
 namespace internal {
 
-// base class for block store
+// base class for block store; blocks may be decoded by concurrent threads,
+// and distinct blocks may also be encoded concurrently when
+// concurrent_encode() holds
 template <class Codec, class Index>
 class BlockStore {
 public:
@@ -142,6 +147,48 @@ public:
   // pointer to compressed data for read or write access
   void* compressed_data() const { return data; }
 
+  // bit offset to block store
+  size_t offset(size_t block_index) const { return index.block_offset(block_index); }
+
+  // can distinct blocks be encoded concurrently?
+  bool concurrent_encode() const
+  {
+    // blocks must be of fixed size and start on word boundaries
+    return !index.has_variable_rate() && !(offset(1) % (codec.alignment() * CHAR_BIT));
+  }
+
+  // call function(codec, i) for 0 <= i < n, concurrently when compiled with
+  // OpenMP and concurrent = true; threads share the reentrant codec
+  template <class Function>
+  void for_each(size_t n, const Function& function, bool concurrent = true) const
+  {
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(static) if (concurrent && n > 1)
+#endif
+    for (ptrdiff_t i = 0; i < static_cast<ptrdiff_t>(n); i++)
+      function(codec, static_cast<size_t>(i));
+    (void)concurrent;
+  }
+
+  // encode all blocks of cleared store in order; encoder(codec, offset, b)
+  // encodes block b at the given bit offset and returns its size in bits
+  template <class Encoder>
+  void encode_all(const Encoder& encoder)
+  {
+    const size_t n = blocks();
+    int threads = 1;
+#ifdef _OPENMP
+    threads = omp_get_max_threads();
+#endif
+    if (concurrent_encode())
+      for_each(n, FixedEncoder<Encoder>(*this, encoder));
+    else if (threads == 1 || n < 2)
+      for (size_t b = 0; b < n; b++)
+        index.set_block_size(b, encoder(codec, offset(b), b));
+    else
+      encode_chunks(encoder, threads);
+  }
+
 protected:
   // protected default constructor
   BlockStore() :
@@ -202,8 +249,65 @@ protected:
     }
   }
 
-  // bit offset to block store
-  size_t offset(size_t block_index) const { return index.block_offset(block_index); }
+  // encoder of fixed-size block at its final location
+  template <class Encoder>
+  class FixedEncoder {
+  public:
+    FixedEncoder(const BlockStore& store, const Encoder& encoder) : store(store), encoder(encoder) {}
+    void operator()(const Codec& codec, size_t block_index) const { encoder(codec, store.offset(block_index), block_index); }
+  protected:
+    const BlockStore& store;
+    const Encoder& encoder;
+  };
+
+  // encode variable-size blocks concurrently by having each thread encode a
+  // contiguous chunk of blocks to a private buffer, then concatenate chunks
+  template <class Encoder>
+  void encode_chunks(const Encoder& encoder, int threads)
+  {
+    const size_t n = blocks();
+    const size_t chunk = 0x400;                   // blocks per thread and pass
+    const size_t maxbits = bytes * CHAR_BIT / n;  // upper bound on block size
+    const size_t chunk_bytes = zfp::round_up(chunk * maxbits, codec.alignment() * CHAR_BIT) / CHAR_BIT + codec.alignment();
+    uchar* buffer = static_cast<uchar*>(zfp::allocate_aligned(threads * chunk_bytes, ZFP_MEMORY_ALIGNMENT));
+    size_t* size = new size_t[threads * chunk];
+    bitstream* dst = stream_open(data, bytes);
+    for (size_t b0 = 0; b0 < n; b0 += threads * chunk) {
+      // encode one chunk per thread
+#ifdef _OPENMP
+      #pragma omp parallel
+#endif
+      {
+        Codec c;
+        c = codec;
+#ifdef _OPENMP
+        #pragma omp for schedule(static)
+#endif
+        for (int t = 0; t < threads; t++) {
+          c.open(buffer + t * chunk_bytes, chunk_bytes);
+          size_t bits = 0;
+          for (size_t b = b0 + t * chunk; b < std::min(b0 + (t + 1) * chunk, n); b++)
+            bits += size[b - b0] = encoder(c, bits, b);
+          c.close();
+        }
+      }
+      // append chunks in order and record block sizes
+      for (int t = 0; t < threads; t++) {
+        size_t bits = 0;
+        for (size_t b = b0 + t * chunk; b < std::min(b0 + (t + 1) * chunk, n); b++) {
+          index.set_block_size(b, size[b - b0]);
+          bits += size[b - b0];
+        }
+        bitstream* src = stream_open(buffer + t * chunk_bytes, chunk_bytes);
+        stream_copy(dst, src, bits);
+        stream_close(src);
+      }
+    }
+    stream_flush(dst);
+    stream_close(dst);
+    delete[] size;
+    zfp::deallocate_aligned(buffer);
+  }
 
   // shape 0 <= m <= 3 of block containing index i, 0 <= i <= n - 1
   static uint shape_code(size_t i, size_t n)
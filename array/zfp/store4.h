@@ -123,10 +123,29 @@ public:
     return codec.decode_block_strided(offset(block_index), block_shape(block_index), p, sx, sy, sz, sw);
   }
 
+  // encode contiguous block with given index at given bit offset using codec c
+  size_t encode(const Codec& c, size_t offset, size_t block_index, const Scalar* block) const
+  {
+    return c.encode_block(offset, block_shape(block_index), block);
+  }
+
+  // encode block with given index from strided array at given bit offset using codec c
+  size_t encode(const Codec& c, size_t offset, size_t block_index, const Scalar* p, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz, ptrdiff_t sw) const
+  {
+    return c.encode_block_strided(offset, block_shape(block_index), p, sx, sy, sz, sw);
+  }
+
+  // decode block with given index to strided array using codec c
+  size_t decode(const Codec& c, size_t block_index, Scalar* p, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz, ptrdiff_t sw) const
+  {
+    return c.decode_block_strided(offset(block_index), block_shape(block_index), p, sx, sy, sz, sw);
+  }
+
+  using BlockStore<Codec, Index>::offset;
+
 protected:
   using BlockStore<Codec, Index>::alloc;
   using BlockStore<Codec, Index>::free;
-  using BlockStore<Codec, Index>::offset;
   using BlockStore<Codec, Index>::shape_code;
   using BlockStore<Codec, Index>::index;
   using BlockStore<Codec, Index>::codec;
@@ -73,6 +73,13 @@ public:
   const_iterator begin() const { return cbegin(); }
   const_iterator end() const { return cend(); }
 
+  // decode blocks overlapping ni elements starting at i0 into cache ahead of use
+  void prefetch(size_t i0, size_t ni) const
+  {
+    if (i0 < nx)
+      array->prefetch(x + i0, std::min(ni, nx - i0));
+  }
+
 protected:
   friend class zfp::internal::dim1::const_handle<const_view>;
   friend class zfp::internal::dim1::const_pointer<const_view>;
@@ -183,6 +190,13 @@ public:
   // empty cache without compressing modified cached blocks
   void clear_cache() const { cache.clear(); }
 
+  // decode blocks overlapping ni elements starting at i0 into cache ahead of use
+  void prefetch(size_t i0, size_t ni) const
+  {
+    if (i0 < nx)
+      cache.prefetch(x + i0, std::min(ni, nx - i0));
+  }
+
   // (i) inspector
   const_reference operator()(size_t i) const { return const_reference(this, x + i); }
 
@@ -75,6 +75,14 @@ public:
   const_iterator begin() const { return cbegin(); }
   const_iterator end() const { return cend(); }
 
+  // decode blocks overlapping ni * nj subarray with origin (i0, j0)
+  // into cache ahead of use
+  void prefetch(size_t i0, size_t j0, size_t ni, size_t nj) const
+  {
+    if (i0 < nx && j0 < ny)
+      array->prefetch(x + i0, y + j0, std::min(ni, nx - i0), std::min(nj, ny - j0));
+  }
+
 protected:
   friend class zfp::internal::dim2::const_handle<const_view>;
   friend class zfp::internal::dim2::const_pointer<const_view>;
@@ -367,6 +375,14 @@ public:
   // empty cache without compressing modified cached blocks
   void clear_cache() const { cache.clear(); }
 
+  // decode blocks overlapping ni * nj subarray with origin (i0, j0)
+  // into cache ahead of use
+  void prefetch(size_t i0, size_t j0, size_t ni, size_t nj) const
+  {
+    if (i0 < nx && j0 < ny)
+      cache.prefetch(x + i0, y + j0, std::min(ni, nx - i0), std::min(nj, ny - j0));
+  }
+
   // (i, j) inspector
   const_reference operator()(size_t i, size_t j) const { return const_reference(this, x + i, y + j); }
 
@@ -80,6 +80,14 @@ public:
   const_iterator begin() const { return cbegin(); }
   const_iterator end() const { return cend(); }
 
+  // decode blocks overlapping ni * nj * nk subarray with origin (i0, j0, k0)
+  // into cache ahead of use
+  void prefetch(size_t i0, size_t j0, size_t k0, size_t ni, size_t nj, size_t nk) const
+  {
+    if (i0 < nx && j0 < ny && k0 < nz)
+      array->prefetch(x + i0, y + j0, z + k0, std::min(ni, nx - i0), std::min(nj, ny - j0), std::min(nk, nz - k0));
+  }
+
 protected:
   friend class zfp::internal::dim3::const_handle<const_view>;
   friend class zfp::internal::dim3::const_pointer<const_view>;
@@ -443,6 +451,14 @@ public:
   // empty cache without compressing modified cached blocks
   void clear_cache() const { cache.clear(); }
 
+  // decode blocks overlapping ni * nj * nk subarray with origin (i0, j0, k0)
+  // into cache ahead of use
+  void prefetch(size_t i0, size_t j0, size_t k0, size_t ni, size_t nj, size_t nk) const
+  {
+    if (i0 < nx && j0 < ny && k0 < nz)
+      cache.prefetch(x + i0, y + j0, z + k0, std::min(ni, nx - i0), std::min(nj, ny - j0), std::min(nk, nz - k0));
+  }
+
   // (i, j, k) inspector
   const_reference operator()(size_t i, size_t j, size_t k) const { return const_reference(this, x + i, y + j, z + k); }
 
@@ -176,51 +176,54 @@ public:
     cache.resize(bytes);
   }
 
+  // number of cache lines per set (one if direct mapped)
+  uint cache_associativity() const { return cache.associativity(); }
+
+  // cache replacement policy within sets
+  zfp::cache_policy cache_replacement() const { return cache.replacement(); }
+
+  // set minimum number of cache lines per set and replacement policy
+  void set_cache_associativity(uint ways, zfp::cache_policy policy = zfp::cache_lru) { cache.set_associativity(ways, policy); }
+
+  // fraction of cache accesses since last reconfiguration that hit
+  double cache_hit_ratio() const { return cache.hit_ratio(); }
+
+  // is cache safe to access from concurrent threads?
+  bool cache_concurrent() const { return cache.concurrent(); }
+
+  // enable or disable locking of cache for access by concurrent threads
+  void set_cache_concurrent(bool concurrent) { cache.set_concurrent(concurrent); }
+
   // empty cache without compressing modified cached blocks
   void clear_cache() const { cache.clear(); }
 
   // flush cache by compressing all modified cached blocks
   void flush_cache() const { cache.flush(); }
 
+  // decode blocks overlapping ni * nj * nk subarray with origin (i0, j0, k0)
+  // into cache ahead of use
+  void prefetch(size_t i0, size_t j0, size_t k0, size_t ni, size_t nj, size_t nk) const
+  {
+    if (i0 < nx && j0 < ny && k0 < nz)
+      cache.prefetch(i0, j0, k0, std::min(ni, nx - i0), std::min(nj, ny - j0), std::min(nk, nz - k0));
+  }
+
   // decompress array and store at p
   void get(value_type* p) const
   {
-    const size_t bx = store.block_size_x();
-    const size_t by = store.block_size_y();
-    const size_t bz = store.block_size_z();
     const ptrdiff_t sx = 1;
     const ptrdiff_t sy = static_cast<ptrdiff_t>(nx);
     const ptrdiff_t sz = static_cast<ptrdiff_t>(nx * ny);
-    size_t block_index = 0;
-    for (size_t k = 0; k < bz; k++, p += 4 * sy * ptrdiff_t(ny - by))
-      for (size_t j = 0; j < by; j++, p += 4 * sx * ptrdiff_t(nx - bx))
-        for (size_t i = 0; i < bx; i++, p += 4)
-          cache.get_block(block_index++, p, sx, sy, sz);
+    cache.get_blocks(p, sx, sy, sz);
   }
 
   // initialize array by copying and compressing data stored at p
   void set(const value_type* p)
   {
-    const size_t bx = store.block_size_x();
-    const size_t by = store.block_size_y();
-    const size_t bz = store.block_size_z();
-    size_t block_index = 0;
-    if (p) {
-      // compress data stored at p
-      const ptrdiff_t sx = 1;
-      const ptrdiff_t sy = static_cast<ptrdiff_t>(nx);
-      const ptrdiff_t sz = static_cast<ptrdiff_t>(nx * ny);
-      for (size_t k = 0; k < bz; k++, p += 4 * sy * ptrdiff_t(ny - by))
-        for (size_t j = 0; j < by; j++, p += 4 * sx * ptrdiff_t(nx - bx))
-          for (size_t i = 0; i < bx; i++, p += 4)
-            cache.put_block(block_index++, p, sx, sy, sz);
-    }
-    else {
-      // zero-initialize array
-      const value_type block[4 * 4 * 4] = {};
-      while (block_index < bx * by * bz)
-        cache.put_block(block_index++, block, 1, 4, 16);
-    }
+    const ptrdiff_t sx = 1;
+    const ptrdiff_t sy = static_cast<ptrdiff_t>(nx);
+    const ptrdiff_t sz = static_cast<ptrdiff_t>(nx * ny);
+    cache.put_blocks(p, sx, sy, sz);
   }
 
   // (i, j, k) accessors
@@ -168,17 +168,39 @@ public:
     cache.resize(bytes);
   }
 
+  // number of cache lines per set (one if direct mapped)
+  uint cache_associativity() const { return cache.associativity(); }
+
+  // cache replacement policy within sets
+  zfp::cache_policy cache_replacement() const { return cache.replacement(); }
+
+  // set minimum number of cache lines per set and replacement policy
+  void set_cache_associativity(uint ways, zfp::cache_policy policy = zfp::cache_lru) { cache.set_associativity(ways, policy); }
+
+  // fraction of cache accesses since last reconfiguration that hit
+  double cache_hit_ratio() const { return cache.hit_ratio(); }
+
+  // is cache safe to access from concurrent threads?
+  bool cache_concurrent() const { return cache.concurrent(); }
+
+  // enable or disable locking of cache for access by concurrent threads
+  void set_cache_concurrent(bool concurrent) { cache.set_concurrent(concurrent); }
+
   // empty cache without compressing modified cached blocks
   void clear_cache() const { cache.clear(); }
 
+  // decode blocks overlapping ni elements starting at i0 into cache ahead of use
+  void prefetch(size_t i0, size_t ni) const
+  {
+    if (i0 < nx)
+      cache.prefetch(i0, std::min(ni, nx - i0));
+  }
+
   // decompress array and store at p
   void get(value_type* p) const
   {
-    const size_t bx = store.block_size_x();
     const ptrdiff_t sx = 1;
-    size_t block_index = 0;
-    for (size_t i = 0; i < bx; i++, p += 4)
-      cache.get_block(block_index++, p, sx);
+    cache.get_blocks(p, sx);
   }
 
   // initialize array by copying and compressing data stored at p
@@ -186,20 +208,8 @@ public:
   {
     cache.clear();
     store.clear();
-    const size_t bx = store.block_size_x();
-    size_t block_index = 0;
-    if (p) {
-      // compress data stored at p
-      const ptrdiff_t sx = 1;
-      for (size_t i = 0; i < bx; i++, p += 4)
-        store.encode(block_index++, p, sx);
-    }
-    else {
-      // zero-initialize array
-      const value_type block[4] = {};
-      while (block_index < bx)
-        store.encode(block_index++, block);
-    }
+    const ptrdiff_t sx = 1;
+    cache.put_blocks(p, sx);
     store.flush();
     if (compact)
       store.compact();
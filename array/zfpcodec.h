@@ -121,27 +121,47 @@ protected:
   // deep copy
   void deep_copy(const zfp_base& codec)
   {
-    stream = zfp_stream_open(0);
+    close();
     *stream = *codec.stream;
     stream->stream = 0;
   }
 
+  // zfp stream positioned at a block, with compression parameters copied
+  // from the codec and a private bit stream over the codec's buffer
+  class block_stream {
+  public:
+    block_stream(const zfp_stream* codec_stream, size_t offset, bool write) :
+      zfp(*codec_stream)
+    {
+      zfp.stream = stream_clone(codec_stream->stream);
+      if (write)
+        stream_wseek(zfp.stream, offset);
+      else
+        stream_rseek(zfp.stream, offset);
+    }
+
+    ~block_stream() { stream_close(zfp.stream); }
+
+    operator zfp_stream*() { return &zfp; }
+
+  protected:
+    zfp_stream zfp;
+  };
+
   // encode full contiguous block
   size_t encode_block(size_t offset, const Scalar* block) const
   {
-    stream_wseek(stream->stream, offset);
-    size_t size = zfp::encode_block<Scalar, dims>(stream, block);
-    zfp_stream_flush(stream);
+    block_stream s(stream, offset, true);
+    size_t size = zfp::encode_block<Scalar, dims>(s, block);
+    zfp_stream_flush(s);
     return size;
   }
 
   // decode full contiguous block
   size_t decode_block(size_t offset, Scalar* block) const
   {
-    stream_rseek(stream->stream, offset);
-    size_t size = zfp::decode_block<Scalar, dims>(stream, block);
-    zfp_stream_align(stream);
-    return size;
+    block_stream s(stream, offset, false);
+    return zfp::decode_block<Scalar, dims>(s, block);
   }
 
   zfp_stream* stream; // compressed zfp stream
@@ -162,14 +182,14 @@ public:
   size_t encode_block_strided(size_t offset, uint shape, const Scalar* p, ptrdiff_t sx) const
   {
     size_t size;
-    stream_wseek(stream->stream, offset);
+    block_stream s(stream, offset, true);
     if (shape) {
       uint nx = 4 - (shape & 3u); shape >>= 2;
-      size = zfp::encode_partial_block_strided<Scalar>(stream, p, nx, sx);
+      size = zfp::encode_partial_block_strided<Scalar>(s, p, nx, sx);
     }
     else
-      size = zfp::encode_block_strided<Scalar>(stream, p, sx);
-    zfp_stream_flush(stream);
+      size = zfp::encode_block_strided<Scalar>(s, p, sx);
+    zfp_stream_flush(s);
     return size;
   }
 
@@ -184,14 +204,13 @@ public:
   size_t decode_block_strided(size_t offset, uint shape, Scalar* p, ptrdiff_t sx) const
   {
     size_t size;
-    stream_rseek(stream->stream, offset);
+    block_stream s(stream, offset, false);
     if (shape) {
       uint nx = 4 - (shape & 3u); shape >>= 2;
-      size = zfp::decode_partial_block_strided<Scalar>(stream, p, nx, sx);
+      size = zfp::decode_partial_block_strided<Scalar>(s, p, nx, sx);
     }
     else
-      size = zfp::decode_block_strided<Scalar>(stream, p, sx);
-    zfp_stream_align(stream);
+      size = zfp::decode_block_strided<Scalar>(s, p, sx);
     return size;
   }
 
@@ -199,6 +218,7 @@ protected:
   using zfp_base<1, Scalar>::encode_block;
   using zfp_base<1, Scalar>::decode_block;
   using zfp_base<1, Scalar>::stream;
+  typedef typename zfp_base<1, Scalar>::block_stream block_stream;
 };
 
 // 2D codec
@@ -216,15 +236,15 @@ public:
   size_t encode_block_strided(size_t offset, uint shape, const Scalar* p, ptrdiff_t sx, ptrdiff_t sy) const
   {
     size_t size;
-    stream_wseek(stream->stream, offset);
+    block_stream s(stream, offset, true);
     if (shape) {
       uint nx = 4 - (shape & 3u); shape >>= 2;
       uint ny = 4 - (shape & 3u); shape >>= 2;
-      size = zfp::encode_partial_block_strided<Scalar>(stream, p, nx, ny, sx, sy);
+      size = zfp::encode_partial_block_strided<Scalar>(s, p, nx, ny, sx, sy);
     }
     else
-      size = zfp::encode_block_strided<Scalar>(stream, p, sx, sy);
-    zfp_stream_flush(stream);
+      size = zfp::encode_block_strided<Scalar>(s, p, sx, sy);
+    zfp_stream_flush(s);
     return size;
   }
 
@@ -239,15 +259,14 @@ public:
   size_t decode_block_strided(size_t offset, uint shape, Scalar* p, ptrdiff_t sx, ptrdiff_t sy) const
   {
     size_t size;
-    stream_rseek(stream->stream, offset);
+    block_stream s(stream, offset, false);
     if (shape) {
       uint nx = 4 - (shape & 3u); shape >>= 2;
       uint ny = 4 - (shape & 3u); shape >>= 2;
-      size = zfp::decode_partial_block_strided<Scalar>(stream, p, nx, ny, sx, sy);
+      size = zfp::decode_partial_block_strided<Scalar>(s, p, nx, ny, sx, sy);
     }
     else
-      size = zfp::decode_block_strided<Scalar>(stream, p, sx, sy);
-    zfp_stream_align(stream);
+      size = zfp::decode_block_strided<Scalar>(s, p, sx, sy);
     return size;
   }
 
@@ -255,6 +274,7 @@ protected:
   using zfp_base<2, Scalar>::encode_block;
   using zfp_base<2, Scalar>::decode_block;
   using zfp_base<2, Scalar>::stream;
+  typedef typename zfp_base<2, Scalar>::block_stream block_stream;
 };
 
 // 3D codec
@@ -272,16 +292,16 @@ public:
   size_t encode_block_strided(size_t offset, uint shape, const Scalar* p, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz) const
   {
     size_t size;
-    stream_wseek(stream->stream, offset);
+    block_stream s(stream, offset, true);
     if (shape) {
       uint nx = 4 - (shape & 3u); shape >>= 2;
       uint ny = 4 - (shape & 3u); shape >>= 2;
       uint nz = 4 - (shape & 3u); shape >>= 2;
-      size = zfp::encode_partial_block_strided<Scalar>(stream, p, nx, ny, nz, sx, sy, sz);
+      size = zfp::encode_partial_block_strided<Scalar>(s, p, nx, ny, nz, sx, sy, sz);
     }
     else
-      size = zfp::encode_block_strided<Scalar>(stream, p, sx, sy, sz);
-    zfp_stream_flush(stream);
+      size = zfp::encode_block_strided<Scalar>(s, p, sx, sy, sz);
+    zfp_stream_flush(s);
     return size;
   }
 
@@ -296,16 +316,15 @@ public:
   size_t decode_block_strided(size_t offset, uint shape, Scalar* p, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz) const
   {
     size_t size;
-    stream_rseek(stream->stream, offset);
+    block_stream s(stream, offset, false);
     if (shape) {
       uint nx = 4 - (shape & 3u); shape >>= 2;
       uint ny = 4 - (shape & 3u); shape >>= 2;
       uint nz = 4 - (shape & 3u); shape >>= 2;
-      size = zfp::decode_partial_block_strided<Scalar>(stream, p, nx, ny, nz, sx, sy, sz);
+      size = zfp::decode_partial_block_strided<Scalar>(s, p, nx, ny, nz, sx, sy, sz);
     }
     else
-      size = zfp::decode_block_strided<Scalar>(stream, p, sx, sy, sz);
-    zfp_stream_align(stream);
+      size = zfp::decode_block_strided<Scalar>(s, p, sx, sy, sz);
     return size;
   }
 
@@ -313,6 +332,7 @@ protected:
   using zfp_base<3, Scalar>::encode_block;
   using zfp_base<3, Scalar>::decode_block;
   using zfp_base<3, Scalar>::stream;
+  typedef typename zfp_base<3, Scalar>::block_stream block_stream;
 };
 
 // 4D codec
@@ -330,17 +350,17 @@ public:
   size_t encode_block_strided(size_t offset, uint shape, const Scalar* p, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz, ptrdiff_t sw) const
   {
     size_t size;
-    stream_wseek(stream->stream, offset);
+    block_stream s(stream, offset, true);
     if (shape) {
       uint nx = 4 - (shape & 3u); shape >>= 2;
       uint ny = 4 - (shape & 3u); shape >>= 2;
       uint nz = 4 - (shape & 3u); shape >>= 2;
       uint nw = 4 - (shape & 3u); shape >>= 2;
-      size = zfp::encode_partial_block_strided<Scalar>(stream, p, nx, ny, nz, nw, sx, sy, sz, sw);
+      size = zfp::encode_partial_block_strided<Scalar>(s, p, nx, ny, nz, nw, sx, sy, sz, sw);
     }
     else
-      size = zfp::encode_block_strided<Scalar>(stream, p, sx, sy, sz, sw);
-    zfp_stream_flush(stream);
+      size = zfp::encode_block_strided<Scalar>(s, p, sx, sy, sz, sw);
+    zfp_stream_flush(s);
     return size;
   }
 
@@ -355,17 +375,16 @@ public:
   size_t decode_block_strided(size_t offset, uint shape, Scalar* p, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz, ptrdiff_t sw) const
   {
     size_t size;
-    stream_rseek(stream->stream, offset);
+    block_stream s(stream, offset, false);
     if (shape) {
       uint nx = 4 - (shape & 3u); shape >>= 2;
       uint ny = 4 - (shape & 3u); shape >>= 2;
       uint nz = 4 - (shape & 3u); shape >>= 2;
       uint nw = 4 - (shape & 3u); shape >>= 2;
-      size = zfp::decode_partial_block_strided<Scalar>(stream, p, nx, ny, nz, nw, sx, sy, sz, sw);
+      size = zfp::decode_partial_block_strided<Scalar>(s, p, nx, ny, nz, nw, sx, sy, sz, sw);
     }
     else
-      size = zfp::decode_block_strided<Scalar>(stream, p, sx, sy, sz, sw);
-    zfp_stream_align(stream);
+      size = zfp::decode_block_strided<Scalar>(s, p, sx, sy, sz, sw);
     return size;
   }
 
@@ -373,6 +392,7 @@ protected:
   using zfp_base<4, Scalar>::encode_block;
   using zfp_base<4, Scalar>::decode_block;
   using zfp_base<4, Scalar>::stream;
+  typedef typename zfp_base<4, Scalar>::block_stream block_stream;
 };
 
 } // codec
@@ -12,6 +12,10 @@ template <typename Scalar, uint dims>
 inline size_t
 encode_block(zfp_stream* zfp, const Scalar* block);
 
+template <typename Scalar, uint dims>
+inline size_t
+encode_blocks(zfp_stream* zfp, const Scalar* blocks, size_t count, size_t* offsets = 0);
+
 template <typename Scalar>
 inline size_t
 encode_block_strided(zfp_stream* zfp, const Scalar* p, ptrdiff_t sx);
@@ -78,6 +82,38 @@ template<>
 inline size_t
 encode_block<double, 4>(zfp_stream* zfp, const double* block) { return zfp_encode_block_double_4(zfp, block); }
 
+template<>
+inline size_t
+encode_blocks<float, 1>(zfp_stream* zfp, const float* blocks, size_t count, size_t* offsets) { return zfp_encode_blocks_float_1(zfp, blocks, count, offsets); }
+
+template<>
+inline size_t
+encode_blocks<float, 2>(zfp_stream* zfp, const float* blocks, size_t count, size_t* offsets) { return zfp_encode_blocks_float_2(zfp, blocks, count, offsets); }
+
+template<>
+inline size_t
+encode_blocks<float, 3>(zfp_stream* zfp, const float* blocks, size_t count, size_t* offsets) { return zfp_encode_blocks_float_3(zfp, blocks, count, offsets); }
+
+template<>
+inline size_t
+encode_blocks<float, 4>(zfp_stream* zfp, const float* blocks, size_t count, size_t* offsets) { return zfp_encode_blocks_float_4(zfp, blocks, count, offsets); }
+
+template<>
+inline size_t
+encode_blocks<double, 1>(zfp_stream* zfp, const double* blocks, size_t count, size_t* offsets) { return zfp_encode_blocks_double_1(zfp, blocks, count, offsets); }
+
+template<>
+inline size_t
+encode_blocks<double, 2>(zfp_stream* zfp, const double* blocks, size_t count, size_t* offsets) { return zfp_encode_blocks_double_2(zfp, blocks, count, offsets); }
+
+template<>
+inline size_t
+encode_blocks<double, 3>(zfp_stream* zfp, const double* blocks, size_t count, size_t* offsets) { return zfp_encode_blocks_double_3(zfp, blocks, count, offsets); }
+
+template<>
+inline size_t
+encode_blocks<double, 4>(zfp_stream* zfp, const double* blocks, size_t count, size_t* offsets) { return zfp_encode_blocks_double_4(zfp, blocks, count, offsets); }
+
 template <>
 inline size_t
 encode_block_strided<float>(zfp_stream* zfp, const float* p, ptrdiff_t sx) { return zfp_encode_block_strided_float_1(zfp, p, sx); }
@@ -150,6 +186,10 @@ template <typename Scalar, uint dims>
 inline size_t
 decode_block(zfp_stream* zfp, Scalar* block);
 
+template <typename Scalar, uint dims>
+inline size_t
+decode_blocks(zfp_stream* zfp, Scalar* blocks, size_t count, size_t* offsets = 0);
+
 template <typename Scalar>
 inline size_t
 decode_block_strided(zfp_stream* zfp, Scalar* p, ptrdiff_t sx);
@@ -216,6 +256,38 @@ template<>
 inline size_t
 decode_block<double, 4>(zfp_stream* zfp, double* block) { return zfp_decode_block_double_4(zfp, block); }
 
+template<>
+inline size_t
+decode_blocks<float, 1>(zfp_stream* zfp, float* blocks, size_t count, size_t* offsets) { return zfp_decode_blocks_float_1(zfp, blocks, count, offsets); }
+
+template<>
+inline size_t
+decode_blocks<float, 2>(zfp_stream* zfp, float* blocks, size_t count, size_t* offsets) { return zfp_decode_blocks_float_2(zfp, blocks, count, offsets); }
+
+template<>
+inline size_t
+decode_blocks<float, 3>(zfp_stream* zfp, float* blocks, size_t count, size_t* offsets) { return zfp_decode_blocks_float_3(zfp, blocks, count, offsets); }
+
+template<>
+inline size_t
+decode_blocks<float, 4>(zfp_stream* zfp, float* blocks, size_t count, size_t* offsets) { return zfp_decode_blocks_float_4(zfp, blocks, count, offsets); }
+
+template<>
+inline size_t
+decode_blocks<double, 1>(zfp_stream* zfp, double* blocks, size_t count, size_t* offsets) { return zfp_decode_blocks_double_1(zfp, blocks, count, offsets); }
+
+template<>
+inline size_t
+decode_blocks<double, 2>(zfp_stream* zfp, double* blocks, size_t count, size_t* offsets) { return zfp_decode_blocks_double_2(zfp, blocks, count, offsets); }
+
+template<>
+inline size_t
+decode_blocks<double, 3>(zfp_stream* zfp, double* blocks, size_t count, size_t* offsets) { return zfp_decode_blocks_double_3(zfp, blocks, count, offsets); }
+
+template<>
+inline size_t
+decode_blocks<double, 4>(zfp_stream* zfp, double* blocks, size_t count, size_t* offsets) { return zfp_decode_blocks_double_4(zfp, blocks, count, offsets); }
+
 template <>
 inline size_t
 decode_block_strided<float>(zfp_stream* zfp, float* p, ptrdiff_t sx) { return zfp_decode_block_strided_float_1(zfp, p, sx); }
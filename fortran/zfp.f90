@@ -30,7 +30,12 @@ module zFORp
                   zFORp_type_int32 = 1, &
                   zFORp_type_int64 = 2, &
                   zFORp_type_float = 3, &
-                  zFORp_type_double = 4
+                  zFORp_type_double = 4, &
+                  zFORp_type_half = 5, &
+                  zFORp_type_bfloat16 = 6, &
+                  zFORp_type_uint8 = 7, &
+                  zFORp_type_uint16 = 8, &
+                  zFORp_type_int16 = 9
   end enum
 
   enum, bind(c)
@@ -45,7 +50,8 @@ module zFORp
   enum, bind(c)
     enumerator :: zFORp_exec_serial = 0, &
                   zFORp_exec_omp = 1, &
-                  zFORp_exec_cuda = 2
+                  zFORp_exec_cuda = 2, &
+                  zFORp_exec_threads = 3
   end enum
 
   ! constants are hardcoded
@@ -105,7 +111,7 @@ module zFORp
   integer, parameter :: const_zFORp_meta_bits = 52
   integer, parameter :: const_zFORp_mode_short_bits = 12
   integer, parameter :: const_zFORp_mode_long_bits = 64
-  integer, parameter :: const_zFORp_header_max_bits = 148
+  integer, parameter :: const_zFORp_header_max_bits = 149
   integer, parameter :: const_zFORp_mode_short_max = 4094
   integer, protected, bind(c, name="zFORp_magic_bits") :: zFORp_magic_bits
   integer, protected, bind(c, name="zFORp_meta_bits") :: zFORp_meta_bits
@@ -304,6 +310,31 @@ module zFORp
       integer(c_int) chunk_size, is_success
     end function
 
+    function zfp_stream_thread_count(stream) result(num_threads) bind(c, name="zfp_stream_thread_count")
+      import
+      type(c_ptr), value :: stream
+      integer(c_int) num_threads
+    end function
+
+    function zfp_stream_thread_chunk_size(stream) result(chunk_size_blocks) bind(c, name="zfp_stream_thread_chunk_size")
+      import
+      type(c_ptr), value :: stream
+      integer(c_int) chunk_size_blocks
+    end function
+
+    function zfp_stream_set_thread_count(stream, threads) result(is_success) bind(c, name="zfp_stream_set_thread_count")
+      import
+      type(c_ptr), value :: stream
+      integer(c_int) threads, is_success
+    end function
+
+    function zfp_stream_set_thread_chunk_size(stream, chunk_size) result(is_success) &
+        bind(c, name="zfp_stream_set_thread_chunk_size")
+      import
+      type(c_ptr), value :: stream
+      integer(c_int) chunk_size, is_success
+    end function
+
     ! TODO: high-level API: zfp_config functions (resolve Fortran's lack of unions)
 
     ! zfp_config_none
@@ -526,7 +557,12 @@ module zFORp
             zFORp_type_int32, &
             zFORp_type_int64, &
             zFORp_type_float, &
-            zFORp_type_double
+            zFORp_type_double, &
+            zFORp_type_half, &
+            zFORp_type_bfloat16, &
+            zFORp_type_uint8, &
+            zFORp_type_uint16, &
+            zFORp_type_int16
 
   public :: zFORp_mode_null, &
             zFORp_mode_expert, &
@@ -537,7 +573,8 @@ module zFORp
 
   public :: zFORp_exec_serial, &
             zFORp_exec_omp, &
-            zFORp_exec_cuda
+            zFORp_exec_cuda, &
+            zFORp_exec_threads
 
   ! C macros -> constants
   public :: zFORp_version_major, &
@@ -603,7 +640,11 @@ module zFORp
             zFORp_stream_omp_chunk_size, &
             zFORp_stream_set_execution, &
             zFORp_stream_set_omp_threads, &
-            zFORp_stream_set_omp_chunk_size
+            zFORp_stream_set_omp_chunk_size, &
+            zFORp_stream_thread_count, &
+            zFORp_stream_thread_chunk_size, &
+            zFORp_stream_set_thread_count, &
+            zFORp_stream_set_thread_chunk_size
 
   ! TODO: high-level API: compression mode and parameter settings
 
@@ -873,6 +914,38 @@ contains
     is_success = zfp_stream_set_omp_chunk_size(stream%object, int(chunk_size, c_int))
   end function zFORp_stream_set_omp_chunk_size
 
+  function zFORp_stream_thread_count(stream) result(thread_count) bind(c, name="zforp_stream_thread_count")
+    implicit none
+    type(zFORp_stream), intent(in) :: stream
+    integer :: thread_count
+    thread_count = zfp_stream_thread_count(stream%object)
+  end function zFORp_stream_thread_count
+
+  function zFORp_stream_thread_chunk_size(stream) result(chunk_size_blocks) bind(c, name="zforp_stream_thread_chunk_size")
+    implicit none
+    type(zFORp_stream), intent(in) :: stream
+    integer (kind=8) :: chunk_size_blocks
+    chunk_size_blocks = zfp_stream_thread_chunk_size(stream%object)
+  end function zFORp_stream_thread_chunk_size
+
+  function zFORp_stream_set_thread_count(stream, thread_count) result(is_success) &
+      bind(c, name="zforp_stream_set_thread_count")
+    implicit none
+    type(zFORp_stream), intent(in) :: stream
+    integer, intent(in) :: thread_count
+    integer :: is_success
+    is_success = zfp_stream_set_thread_count(stream%object, int(thread_count, c_int))
+  end function zFORp_stream_set_thread_count
+
+  function zFORp_stream_set_thread_chunk_size(stream, chunk_size) result(is_success) &
+      bind(c, name="zforp_stream_set_thread_chunk_size")
+    implicit none
+    type(zFORp_stream), intent(in) :: stream
+    integer, intent(in) :: chunk_size
+    integer :: is_success
+    is_success = zfp_stream_set_thread_chunk_size(stream%object, int(chunk_size, c_int))
+  end function zFORp_stream_set_thread_chunk_size
+
   ! TODO: high-level API: compression mode and parameter settings
 
   ! zfp_config_none
@@ -8,6 +8,12 @@
 /* forward declaration of opaque type */
 typedef struct bitstream bitstream;
 
+/* callback that consumes bytes drained from stream; returns bytes consumed */
+typedef size_t (*stream_sink)(const void* data, size_t bytes, void* context);
+
+/* callback that produces bytes to refill stream; returns bytes produced */
+typedef size_t (*stream_source)(void* data, size_t bytes, void* context);
+
 extern_ const size_t stream_word_bits; /* bit stream granularity */
 
 #ifndef inline_
@@ -18,6 +24,12 @@ extern "C" {
 /* allocate and initialize bit stream */
 bitstream* stream_open(void* buffer, size_t bytes);
 
+/* allocate bit stream that drains buffer to sink as it fills up */
+bitstream* stream_open_sink(void* buffer, size_t bytes, stream_sink sink, void* context);
+
+/* allocate bit stream that refills buffer from source as it is consumed */
+bitstream* stream_open_source(void* buffer, size_t bytes, stream_source source, void* context);
+
 /* close and deallocate bit stream */
 void stream_close(bitstream* stream);
 
@@ -36,6 +48,12 @@ size_t stream_size(const bitstream* stream);
 /* byte capacity of stream */
 size_t stream_capacity(const bitstream* stream);
 
+/* nonzero if sink has failed to consume drained words or seek has failed */
+int stream_error(const bitstream* stream);
+
+/* nonzero if stream drains to sink or refills from source */
+int stream_is_callback(const bitstream* stream);
+
 /* number of words per block */
 size_t stream_stride_block(const bitstream* stream);
 
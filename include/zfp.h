@@ -20,12 +20,16 @@
 #define ZFP_MAX_PREC    64 /* maximum precision supported */
 #define ZFP_MIN_EXP  -1074 /* minimum floating-point base-2 exponent */
 
+/* maximum number of interleaved components per field point */
+#define ZFP_MAX_COMPONENTS 16
+
 /* header masks (enable via bitwise or; reader must use same mask) */
 #define ZFP_HEADER_NONE   0x0u /* no header */
 #define ZFP_HEADER_MAGIC  0x1u /* embed 64-bit magic */
 #define ZFP_HEADER_META   0x2u /* embed 52-bit field metadata */
 #define ZFP_HEADER_MODE   0x4u /* embed 12- or 64-bit compression mode */
 #define ZFP_HEADER_FULL   0x7u /* embed all of the above */
+#define ZFP_HEADER_INDEX  0x8u /* embed 1-bit chunk index flag */
 
 /* bit masks for specifying storage class */
 #define ZFP_DATA_UNUSED  0x01u /* allocated but unused storage */
@@ -46,7 +50,8 @@
 #define ZFP_META_BITS        52 /* number of field metadata bits */
 #define ZFP_MODE_SHORT_BITS  12 /* number of mode bits in short format */
 #define ZFP_MODE_LONG_BITS   64 /* number of mode bits in long format */
-#define ZFP_HEADER_MAX_BITS 148 /* max number of header bits */
+#define ZFP_INDEX_BITS        1 /* number of chunk index flag bits */
+#define ZFP_HEADER_MAX_BITS 149 /* max number of header bits */
 #define ZFP_MODE_SHORT_MAX  ((1u << ZFP_MODE_SHORT_BITS) - 2)
 
 /* rounding mode for reducing bias; see build option ZFP_ROUNDING_MODE */
@@ -66,9 +71,10 @@ typedef int zfp_bool; /* Boolean type */
 
 /* execution policy */
 typedef enum {
-  zfp_exec_serial = 0, /* serial execution (default) */
-  zfp_exec_omp    = 1, /* OpenMP multi-threaded execution */
-  zfp_exec_cuda   = 2  /* CUDA parallel execution */
+  zfp_exec_serial  = 0, /* serial execution (default) */
+  zfp_exec_omp     = 1, /* OpenMP multi-threaded execution */
+  zfp_exec_cuda    = 2, /* CUDA parallel execution */
+  zfp_exec_threads = 3  /* native multi-threaded execution */
 } zfp_exec_policy;
 
 /* OpenMP execution parameters */
@@ -77,9 +83,16 @@ typedef struct {
   uint chunk_size; /* number of blocks per chunk (1D only) */
 } zfp_exec_params_omp;
 
+/* native thread pool execution parameters */
+typedef struct {
+  uint threads;    /* number of requested threads */
+  uint chunk_size; /* number of blocks per chunk */
+} zfp_exec_params_threads;
+
 /* execution parameters */
 typedef union {
-  zfp_exec_params_omp omp; /* OpenMP parameters */
+  zfp_exec_params_omp omp;         /* OpenMP parameters */
+  zfp_exec_params_threads threads; /* native thread pool parameters */
 } zfp_exec_params;
 
 typedef struct {
@@ -87,16 +100,46 @@ typedef struct {
   zfp_exec_params params; /* execution parameters */
 } zfp_execution;
 
+/* scalar type */
+typedef enum {
+  zfp_type_none     = 0, /* unspecified type */
+  zfp_type_int32    = 1, /* 32-bit signed integer */
+  zfp_type_int64    = 2, /* 64-bit signed integer */
+  zfp_type_float    = 3, /* single precision floating point */
+  zfp_type_double   = 4, /* double precision floating point */
+  zfp_type_half     = 5, /* half precision floating point (IEEE binary16) */
+  zfp_type_bfloat16 = 6, /* bfloat16 floating point */
+  zfp_type_uint8    = 7, /* 8-bit unsigned integer */
+  zfp_type_uint16   = 8, /* 16-bit unsigned integer */
+  zfp_type_int16    = 9  /* 16-bit signed integer */
+} zfp_type;
+
+/* uncompressed array; use accessors to get/set members */
+typedef struct {
+  zfp_type type;            /* scalar type (e.g. int32, double) */
+  size_t nx, ny, nz, nw;    /* sizes (zero for unused dimensions) */
+  ptrdiff_t sx, sy, sz, sw; /* strides (zero for contiguous array a[nw][nz][ny][nx]) */
+  void* data;               /* pointer to array data */
+  uint components;          /* interleaved components per point (0 or 1 for scalars) */
+  zfp_type ctype;           /* scalar type values are (de)compressed as (none for default) */
+} zfp_field;
+
 /* compressed stream; use accessors to get/set members */
 typedef struct {
-  uint minbits;       /* minimum number of bits to store per block */
-  uint maxbits;       /* maximum number of bits to store per block */
-  uint maxprec;       /* maximum number of bit planes to store */
-  int minexp;         /* minimum floating point bit plane number to store */
-  bitstream* stream;  /* compressed bit stream */
-  zfp_execution exec; /* execution policy and parameters */
+  uint minbits;         /* minimum number of bits to store per block */
+  uint maxbits;         /* maximum number of bits to store per block */
+  uint maxprec;         /* maximum number of bit planes to store */
+  int minexp;           /* minimum floating point bit plane number to store */
+  bitstream* stream;    /* compressed bit stream */
+  zfp_execution exec;   /* execution policy and parameters */
+  zfp_bool chunk_index; /* precede compressed blocks with chunk offsets */
+  void* scratch;        /* memory reused across parallel (de)compressions */
+  size_t scratch_size;  /* byte size of scratch memory */
 } zfp_stream;
 
+/* opaque cursor over field (de)compressed one slab at a time */
+typedef struct zfp_slab_cursor zfp_slab_cursor;
+
 /* compression mode */
 typedef enum {
   zfp_mode_null            = 0, /* an invalid configuration of the 4 params */
@@ -123,23 +166,6 @@ typedef struct {
   } arg;              /* arguments corresponding to compression mode */
 } zfp_config;
 
-/* scalar type */
-typedef enum {
-  zfp_type_none   = 0, /* unspecified type */
-  zfp_type_int32  = 1, /* 32-bit signed integer */
-  zfp_type_int64  = 2, /* 64-bit signed integer */
-  zfp_type_float  = 3, /* single precision floating point */
-  zfp_type_double = 4  /* double precision floating point */
-} zfp_type;
-
-/* uncompressed array; use accessors to get/set members */
-typedef struct {
-  zfp_type type;            /* scalar type (e.g. int32, double) */
-  size_t nx, ny, nz, nw;    /* sizes (zero for unused dimensions) */
-  ptrdiff_t sx, sy, sz, sw; /* strides (zero for contiguous array a[nw][nz][ny][nx]) */
-  void* data;               /* pointer to array data */
-} zfp_field;
-
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -220,6 +246,12 @@ zfp_stream_params(
   int* minexp               /* minimum base-2 exponent; error <= 2^minexp */
 );
 
+/* whether compressed blocks are preceded by a chunk index */
+zfp_bool                   /* true if chunk index is embedded */
+zfp_stream_chunk_index(
+  const zfp_stream* stream /* compressed stream */
+);
+
 /* byte size of sequentially compressed stream (call after compression) */
 size_t                     /* actual number of bytes of compressed storage */
 zfp_stream_compressed_size(
@@ -233,6 +265,15 @@ zfp_stream_maximum_size(
   const zfp_field* field    /* array to compress */
 );
 
+/* estimate compressed size in bytes by compressing a sample of blocks */
+size_t                      /* estimated number of bytes of compressed storage */
+zfp_stream_estimate_size(
+  const zfp_stream* stream, /* compressed stream */
+  const zfp_field* field,   /* array to compress */
+  double fraction,          /* fraction of blocks to sample in (0, 1] */
+  size_t* bound             /* approximate 95% upper confidence bound (or NULL) */
+);
+
 /* high-level API: initialization of compressed stream parameters ---------- */
 
 /* rewind bit stream to beginning for compression or decompression */
@@ -295,6 +336,13 @@ zfp_stream_set_params(
   int minexp          /* minimum base-2 exponent; error <= 2^minexp */
 );
 
+/* embed chunk index to enable parallel decompression in any mode */
+void
+zfp_stream_set_chunk_index(
+  zfp_stream* stream, /* compressed stream */
+  zfp_bool enable     /* whether to embed chunk index */
+);
+
 /* high-level API: execution policy ---------------------------------------- */
 
 /* current execution policy */
@@ -315,6 +363,18 @@ zfp_stream_omp_chunk_size(
   const zfp_stream* stream /* compressed stream */
 );
 
+/* number of native threads to use */
+uint                       /* number of threads (0 for default) */
+zfp_stream_thread_count(
+  const zfp_stream* stream /* compressed stream */
+);
+
+/* number of blocks per native thread chunk */
+uint                       /* number of blocks per chunk (0 for default) */
+zfp_stream_thread_chunk_size(
+  const zfp_stream* stream /* compressed stream */
+);
+
 /* set execution policy */
 zfp_bool                 /* true upon success */
 zfp_stream_set_execution(
@@ -336,6 +396,32 @@ zfp_stream_set_omp_chunk_size(
   uint chunk_size     /* number of blocks per chunk (0 for default) */
 );
 
+/* set native thread execution policy and number of threads */
+zfp_bool              /* true upon success */
+zfp_stream_set_thread_count(
+  zfp_stream* stream, /* compressed stream */
+  uint threads        /* number of threads to use (0 for default) */
+);
+
+/* set native thread execution policy and number of blocks per chunk */
+zfp_bool              /* true upon success */
+zfp_stream_set_thread_chunk_size(
+  zfp_stream* stream, /* compressed stream */
+  uint chunk_size     /* number of blocks per chunk (0 for default) */
+);
+
+/* byte size of scratch memory retained for parallel (de)compression */
+size_t                     /* number of bytes of scratch memory */
+zfp_stream_scratch_size(
+  const zfp_stream* stream /* compressed stream */
+);
+
+/* release scratch memory retained for parallel (de)compression */
+void
+zfp_stream_release_scratch(
+  zfp_stream* stream /* compressed stream */
+);
+
 /* high-level API: compression mode and parameter settings ----------------- */
 
 /* unspecified configuration */
@@ -444,6 +530,12 @@ zfp_field_type(
   const zfp_field* field /* field metadata */
 );
 
+/* scalar type that field values are (de)compressed as */
+zfp_type                 /* compressed scalar type */
+zfp_field_compressed_type(
+  const zfp_field* field /* field metadata */
+);
+
 /* precision of field scalar type */
 uint                     /* scalar type precision in number of bits */
 zfp_field_precision(
@@ -456,6 +548,12 @@ zfp_field_dimensionality(
   const zfp_field* field /* field metadata */
 );
 
+/* number of interleaved components per point */
+uint                     /* number of components (1 for scalar field) */
+zfp_field_components(
+  const zfp_field* field /* field metadata */
+);
+
 /* field size in number of scalars */
 size_t                    /* total number of scalars */
 zfp_field_size(
@@ -504,6 +602,20 @@ zfp_field_set_type(
   zfp_type type     /* desired scalar type */
 );
 
+/* set scalar type that field values are (de)compressed as */
+zfp_type            /* actual compressed type (zfp_type_none for default) */
+zfp_field_set_compressed_type(
+  zfp_field* field, /* field metadata */
+  zfp_type type     /* desired compressed type (zfp_type_none for default) */
+);
+
+/* set number of interleaved components per point */
+uint                /* actual number of components (zero upon failure) */
+zfp_field_set_components(
+  zfp_field* field, /* field metadata */
+  uint components   /* desired number of components */
+);
+
 /* set 1D field size */
 void
 zfp_field_set_size_1d(
@@ -572,7 +684,7 @@ zfp_field_set_stride_4d(
   ptrdiff_t sw      /* stride in w dimension: &f[1][0][0][0] - &f[0][0][0][0] */
 );
 
-/* set field scalar type and dimensions */
+/* set field scalar type and dimensions; reset components to one */
 zfp_bool            /* true upon success */
 zfp_field_set_metadata(
   zfp_field* field, /* field metadata */
@@ -588,6 +700,29 @@ zfp_compress(
   const zfp_field* field /* field metadata */
 );
 
+/* begin compressing field supplied one slab at a time (data pointer ignored) */
+zfp_slab_cursor*         /* cursor upon success; NULL otherwise */
+zfp_compress_begin(
+  zfp_stream* stream,    /* compressed stream; must persist until zfp_compress_end */
+  const zfp_field* field /* field metadata, which is copied */
+);
+
+/* compress next slab of planes along slowest varying dimension of field;
+   a memory stream must still hold the whole compressed field, whereas a
+   sink stream (stream_open_sink) passes full words on as they are written */
+zfp_bool                   /* true upon success */
+zfp_compress_slab(
+  zfp_slab_cursor* cursor, /* cursor returned by zfp_compress_begin */
+  const void* data,        /* pointer to first value of slab */
+  size_t planes            /* number of planes; multiple of four unless last slab */
+);
+
+/* finish compressing field and deallocate cursor */
+size_t                    /* cumulative number of bytes of compressed storage */
+zfp_compress_end(
+  zfp_slab_cursor* cursor /* cursor returned by zfp_compress_begin */
+);
+
 /* decompress entire field (nonzero return value upon success) */
 size_t                /* cumulative number of bytes of compressed storage */
 zfp_decompress(
@@ -595,6 +730,68 @@ zfp_decompress(
   zfp_field* field    /* field metadata */
 );
 
+/* begin decompressing field one slab at a time (data pointer ignored) */
+zfp_slab_cursor*         /* cursor upon success; NULL otherwise */
+zfp_decompress_begin(
+  zfp_stream* stream,    /* compressed stream; must persist until zfp_decompress_end */
+  const zfp_field* field /* field metadata, which is copied */
+);
+
+/* decompress next slab of planes along slowest varying dimension of field */
+size_t                     /* number of planes decompressed; zero at end of field */
+zfp_decompress_slab(
+  zfp_slab_cursor* cursor, /* cursor returned by zfp_decompress_begin */
+  void* data,              /* pointer to first value of slab */
+  size_t planes            /* maximum number of planes; multiple of four */
+);
+
+/* finish decompressing field and deallocate cursor */
+size_t                    /* cumulative number of bytes of compressed storage */
+zfp_decompress_end(
+  zfp_slab_cursor* cursor /* cursor returned by zfp_decompress_begin */
+);
+
+/* decompress box of values with origin (x, y, z, w) from compressed array */
+zfp_bool                  /* true upon success */
+zfp_decompress_box(
+  zfp_stream* stream,     /* compressed stream positioned at first block */
+  const zfp_field* field, /* type and dimensions of compressed array */
+  zfp_field* box,         /* box extents, strides, and destination pointer */
+  size_t x,               /* index of first box value along x */
+  size_t y,               /* index of first box value along y */
+  size_t z,               /* index of first box value along z */
+  size_t w                /* index of first box value along w */
+);
+
+/* bound magnitudes of floating-point values block by block from exponents */
+zfp_bool                  /* true upon success */
+zfp_stream_block_bounds(
+  zfp_stream* stream,     /* compressed stream positioned at first block */
+  const zfp_field* field, /* type and dimensions of compressed array */
+  const size_t* offsets,  /* bit offsets of blocks (NULL for fixed rate) */
+  double* bounds,         /* per-block bounds on magnitude (may be NULL) */
+  double* min,            /* smallest per-block bound (may be NULL) */
+  double* max             /* largest per-block bound (may be NULL) */
+);
+
+/* scale compressed floating-point values by a, block by block */
+size_t                    /* cumulative number of bytes of output stream */
+zfp_stream_scale(
+  zfp_stream* dst,        /* output stream positioned at first block */
+  zfp_stream* src,        /* input stream positioned at first block */
+  const zfp_field* field, /* type and dimensions of compressed array */
+  double a                /* scale factor */
+);
+
+/* add two compressed floating-point arrays of equal layout block by block */
+size_t                    /* cumulative number of bytes of output stream */
+zfp_stream_add(
+  zfp_stream* dst,        /* output stream positioned at first block */
+  zfp_stream* src1,       /* first input stream positioned at first block */
+  zfp_stream* src2,       /* second input stream positioned at first block */
+  const zfp_field* field  /* type and dimensions of compressed arrays */
+);
+
 /* write compression parameters and field metadata (optional) */
 size_t                    /* number of bits written or zero upon failure */
 zfp_write_header(
@@ -634,7 +831,9 @@ array.  In the latter case, p points to the first scalar; (nx, ny, nz) specify
 the size of the block, with 1 <= nx, ny, nz <= 4; and (sx, sy, sz) specify the
 strides, i.e. the number of scalars to advance to get to the next scalar along
 each dimension.  The functions return the number of bits of compressed storage
-needed for the compressed block.
+needed for the compressed block.  The zfp_encode_blocks functions compress
+count contiguous blocks in sequence, return the total number of bits, and,
+unless offsets is NULL, store the bit offset of each block in offsets.
 */
 
 /* encode 1D contiguous block of 4 values */
@@ -643,6 +842,12 @@ size_t zfp_encode_block_int64_1(zfp_stream* stream, const int64* block);
 size_t zfp_encode_block_float_1(zfp_stream* stream, const float* block);
 size_t zfp_encode_block_double_1(zfp_stream* stream, const double* block);
 
+/* encode count contiguous 1D blocks stored back to back */
+size_t zfp_encode_blocks_int32_1(zfp_stream* stream, const int32* blocks, size_t count, size_t* offsets);
+size_t zfp_encode_blocks_int64_1(zfp_stream* stream, const int64* blocks, size_t count, size_t* offsets);
+size_t zfp_encode_blocks_float_1(zfp_stream* stream, const float* blocks, size_t count, size_t* offsets);
+size_t zfp_encode_blocks_double_1(zfp_stream* stream, const double* blocks, size_t count, size_t* offsets);
+
 /* encode 1D complete or partial block from strided array */
 size_t zfp_encode_block_strided_int32_1(zfp_stream* stream, const int32* p, ptrdiff_t sx);
 size_t zfp_encode_block_strided_int64_1(zfp_stream* stream, const int64* p, ptrdiff_t sx);
@@ -659,6 +864,12 @@ size_t zfp_encode_block_int64_2(zfp_stream* stream, const int64* block);
 size_t zfp_encode_block_float_2(zfp_stream* stream, const float* block);
 size_t zfp_encode_block_double_2(zfp_stream* stream, const double* block);
 
+/* encode count contiguous 2D blocks stored back to back */
+size_t zfp_encode_blocks_int32_2(zfp_stream* stream, const int32* blocks, size_t count, size_t* offsets);
+size_t zfp_encode_blocks_int64_2(zfp_stream* stream, const int64* blocks, size_t count, size_t* offsets);
+size_t zfp_encode_blocks_float_2(zfp_stream* stream, const float* blocks, size_t count, size_t* offsets);
+size_t zfp_encode_blocks_double_2(zfp_stream* stream, const double* blocks, size_t count, size_t* offsets);
+
 /* encode 2D complete or partial block from strided array */
 size_t zfp_encode_partial_block_strided_int32_2(zfp_stream* stream, const int32* p, size_t nx, size_t ny, ptrdiff_t sx, ptrdiff_t sy);
 size_t zfp_encode_partial_block_strided_int64_2(zfp_stream* stream, const int64* p, size_t nx, size_t ny, ptrdiff_t sx, ptrdiff_t sy);
@@ -675,6 +886,12 @@ size_t zfp_encode_block_int64_3(zfp_stream* stream, const int64* block);
 size_t zfp_encode_block_float_3(zfp_stream* stream, const float* block);
 size_t zfp_encode_block_double_3(zfp_stream* stream, const double* block);
 
+/* encode count contiguous 3D blocks stored back to back */
+size_t zfp_encode_blocks_int32_3(zfp_stream* stream, const int32* blocks, size_t count, size_t* offsets);
+size_t zfp_encode_blocks_int64_3(zfp_stream* stream, const int64* blocks, size_t count, size_t* offsets);
+size_t zfp_encode_blocks_float_3(zfp_stream* stream, const float* blocks, size_t count, size_t* offsets);
+size_t zfp_encode_blocks_double_3(zfp_stream* stream, const double* blocks, size_t count, size_t* offsets);
+
 /* encode 3D complete or partial block from strided array */
 size_t zfp_encode_block_strided_int32_3(zfp_stream* stream, const int32* p, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz);
 size_t zfp_encode_block_strided_int64_3(zfp_stream* stream, const int64* p, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz);
@@ -691,6 +908,12 @@ size_t zfp_encode_block_int64_4(zfp_stream* stream, const int64* block);
 size_t zfp_encode_block_float_4(zfp_stream* stream, const float* block);
 size_t zfp_encode_block_double_4(zfp_stream* stream, const double* block);
 
+/* encode count contiguous 4D blocks stored back to back */
+size_t zfp_encode_blocks_int32_4(zfp_stream* stream, const int32* blocks, size_t count, size_t* offsets);
+size_t zfp_encode_blocks_int64_4(zfp_stream* stream, const int64* blocks, size_t count, size_t* offsets);
+size_t zfp_encode_blocks_float_4(zfp_stream* stream, const float* blocks, size_t count, size_t* offsets);
+size_t zfp_encode_blocks_double_4(zfp_stream* stream, const double* blocks, size_t count, size_t* offsets);
+
 /* encode 4D complete or partial block from strided array */
 size_t zfp_encode_block_strided_int32_4(zfp_stream* stream, const int32* p, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz, ptrdiff_t sw);
 size_t zfp_encode_block_strided_int64_4(zfp_stream* stream, const int64* p, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz, ptrdiff_t sw);
@@ -715,6 +938,12 @@ size_t zfp_decode_block_int64_1(zfp_stream* stream, int64* block);
 size_t zfp_decode_block_float_1(zfp_stream* stream, float* block);
 size_t zfp_decode_block_double_1(zfp_stream* stream, double* block);
 
+/* decode count contiguous 1D blocks stored back to back */
+size_t zfp_decode_blocks_int32_1(zfp_stream* stream, int32* blocks, size_t count, size_t* offsets);
+size_t zfp_decode_blocks_int64_1(zfp_stream* stream, int64* blocks, size_t count, size_t* offsets);
+size_t zfp_decode_blocks_float_1(zfp_stream* stream, float* blocks, size_t count, size_t* offsets);
+size_t zfp_decode_blocks_double_1(zfp_stream* stream, double* blocks, size_t count, size_t* offsets);
+
 /* decode 1D complete or partial block from strided array */
 size_t zfp_decode_block_strided_int32_1(zfp_stream* stream, int32* p, ptrdiff_t sx);
 size_t zfp_decode_block_strided_int64_1(zfp_stream* stream, int64* p, ptrdiff_t sx);
@@ -731,6 +960,12 @@ size_t zfp_decode_block_int64_2(zfp_stream* stream, int64* block);
 size_t zfp_decode_block_float_2(zfp_stream* stream, float* block);
 size_t zfp_decode_block_double_2(zfp_stream* stream, double* block);
 
+/* decode count contiguous 2D blocks stored back to back */
+size_t zfp_decode_blocks_int32_2(zfp_stream* stream, int32* blocks, size_t count, size_t* offsets);
+size_t zfp_decode_blocks_int64_2(zfp_stream* stream, int64* blocks, size_t count, size_t* offsets);
+size_t zfp_decode_blocks_float_2(zfp_stream* stream, float* blocks, size_t count, size_t* offsets);
+size_t zfp_decode_blocks_double_2(zfp_stream* stream, double* blocks, size_t count, size_t* offsets);
+
 /* decode 2D complete or partial block from strided array */
 size_t zfp_decode_block_strided_int32_2(zfp_stream* stream, int32* p, ptrdiff_t sx, ptrdiff_t sy);
 size_t zfp_decode_block_strided_int64_2(zfp_stream* stream, int64* p, ptrdiff_t sx, ptrdiff_t sy);
@@ -747,6 +982,12 @@ size_t zfp_decode_block_int64_3(zfp_stream* stream, int64* block);
 size_t zfp_decode_block_float_3(zfp_stream* stream, float* block);
 size_t zfp_decode_block_double_3(zfp_stream* stream, double* block);
 
+/* decode count contiguous 3D blocks stored back to back */
+size_t zfp_decode_blocks_int32_3(zfp_stream* stream, int32* blocks, size_t count, size_t* offsets);
+size_t zfp_decode_blocks_int64_3(zfp_stream* stream, int64* blocks, size_t count, size_t* offsets);
+size_t zfp_decode_blocks_float_3(zfp_stream* stream, float* blocks, size_t count, size_t* offsets);
+size_t zfp_decode_blocks_double_3(zfp_stream* stream, double* blocks, size_t count, size_t* offsets);
+
 /* decode 3D complete or partial block from strided array */
 size_t zfp_decode_block_strided_int32_3(zfp_stream* stream, int32* p, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz);
 size_t zfp_decode_block_strided_int64_3(zfp_stream* stream, int64* p, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz);
@@ -763,6 +1004,12 @@ size_t zfp_decode_block_int64_4(zfp_stream* stream, int64* block);
 size_t zfp_decode_block_float_4(zfp_stream* stream, float* block);
 size_t zfp_decode_block_double_4(zfp_stream* stream, double* block);
 
+/* decode count contiguous 4D blocks stored back to back */
+size_t zfp_decode_blocks_int32_4(zfp_stream* stream, int32* blocks, size_t count, size_t* offsets);
+size_t zfp_decode_blocks_int64_4(zfp_stream* stream, int64* blocks, size_t count, size_t* offsets);
+size_t zfp_decode_blocks_float_4(zfp_stream* stream, float* blocks, size_t count, size_t* offsets);
+size_t zfp_decode_blocks_double_4(zfp_stream* stream, double* blocks, size_t count, size_t* offsets);
+
 /* decode 4D complete or partial block from strided array */
 size_t zfp_decode_block_strided_int32_4(zfp_stream* stream, int32* p, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz, ptrdiff_t sw);
 size_t zfp_decode_block_strided_int64_4(zfp_stream* stream, int64* p, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz, ptrdiff_t sw);
@@ -773,6 +1020,40 @@ size_t zfp_decode_partial_block_strided_int64_4(zfp_stream* stream, int64* p, si
 size_t zfp_decode_partial_block_strided_float_4(zfp_stream* stream, float* p, size_t nx, size_t ny, size_t nz, size_t nw, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz, ptrdiff_t sw);
 size_t zfp_decode_partial_block_strided_double_4(zfp_stream* stream, double* p, size_t nx, size_t ny, size_t nz, size_t nw, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz, ptrdiff_t sw);
 
+/* low-level API: transform coefficients ---------------------------------- */
+
+/*
+The functions below (de)compress a floating-point block in lossy mode without
+applying the decorrelating transform, i.e. they operate directly on the block's
+4^d signed integer transform coefficients in natural (not sequency) order and
+their common exponent, emax.  Each coefficient represents a multiple of
+2^(emax - p + 2), where p is the number of bits in the floating-point type.
+Blocks of all zeros have zero coefficients and emax = 1 - 2^(e - 1), where e
+is the number of exponent bits.  Because the transform is linear, scaling and
+adding coefficients scales and adds the values they represent.  The functions
+return the number of bits of compressed storage, or zero in reversible mode.
+*/
+
+/* encode block of transform coefficients */
+size_t zfp_encode_coefficients_float_1(zfp_stream* stream, const int32* coeffs, int emax);
+size_t zfp_encode_coefficients_double_1(zfp_stream* stream, const int64* coeffs, int emax);
+size_t zfp_encode_coefficients_float_2(zfp_stream* stream, const int32* coeffs, int emax);
+size_t zfp_encode_coefficients_double_2(zfp_stream* stream, const int64* coeffs, int emax);
+size_t zfp_encode_coefficients_float_3(zfp_stream* stream, const int32* coeffs, int emax);
+size_t zfp_encode_coefficients_double_3(zfp_stream* stream, const int64* coeffs, int emax);
+size_t zfp_encode_coefficients_float_4(zfp_stream* stream, const int32* coeffs, int emax);
+size_t zfp_encode_coefficients_double_4(zfp_stream* stream, const int64* coeffs, int emax);
+
+/* decode block of transform coefficients */
+size_t zfp_decode_coefficients_float_1(zfp_stream* stream, int32* coeffs, int* emax);
+size_t zfp_decode_coefficients_double_1(zfp_stream* stream, int64* coeffs, int* emax);
+size_t zfp_decode_coefficients_float_2(zfp_stream* stream, int32* coeffs, int* emax);
+size_t zfp_decode_coefficients_double_2(zfp_stream* stream, int64* coeffs, int* emax);
+size_t zfp_decode_coefficients_float_3(zfp_stream* stream, int32* coeffs, int* emax);
+size_t zfp_decode_coefficients_double_3(zfp_stream* stream, int64* coeffs, int* emax);
+size_t zfp_decode_coefficients_float_4(zfp_stream* stream, int32* coeffs, int* emax);
+size_t zfp_decode_coefficients_double_4(zfp_stream* stream, int64* coeffs, int* emax);
+
 /* low-level API: utility functions ---------------------------------------- */
 
 /* convert dims-dimensional contiguous block to 32-bit integer type */
@@ -10,11 +10,16 @@ cdef extern from "bitstream.h":
 cdef extern from "zfp.h":
     # enums
     ctypedef enum zfp_type:
-        zfp_type_none   = 0,
-        zfp_type_int32  = 1,
-        zfp_type_int64  = 2,
-        zfp_type_float  = 3,
-        zfp_type_double = 4
+        zfp_type_none     = 0,
+        zfp_type_int32    = 1,
+        zfp_type_int64    = 2,
+        zfp_type_float    = 3,
+        zfp_type_double   = 4,
+        zfp_type_half     = 5,
+        zfp_type_bfloat16 = 6,
+        zfp_type_uint8    = 7,
+        zfp_type_uint16   = 8,
+        zfp_type_int16    = 9
 
     ctypedef enum zfp_mode:
         zfp_mode_null            = 0,
@@ -29,6 +29,10 @@ type_int32 = zfp_type_int32
 type_int64 = zfp_type_int64
 type_float = zfp_type_float
 type_double = zfp_type_double
+type_half = zfp_type_half
+type_uint8 = zfp_type_uint8
+type_uint16 = zfp_type_uint16
+type_int16 = zfp_type_int16
 mode_null = zfp_mode_null
 mode_expert = zfp_mode_expert
 mode_fixed_rate = zfp_mode_fixed_rate
@@ -45,6 +49,14 @@ cpdef dtype_to_ztype(dtype):
         return zfp_type_float
     elif dtype == np.float64:
         return zfp_type_double
+    elif dtype == np.float16:
+        return zfp_type_half
+    elif dtype == np.uint8:
+        return zfp_type_uint8
+    elif dtype == np.uint16:
+        return zfp_type_uint16
+    elif dtype == np.int16:
+        return zfp_type_int16
     else:
         raise TypeError("Unknown dtype: {}".format(dtype))
 
@@ -59,6 +71,14 @@ cpdef dtype_to_format(dtype):
         return 'f' # float
     elif dtype == np.float64:
         return 'd' # double
+    elif dtype == np.float16:
+        return 'e' # half
+    elif dtype == np.uint8:
+        return 'B' # unsigned char
+    elif dtype == np.uint16:
+        return 'H' # unsigned short
+    elif dtype == np.int16:
+        return 'h' # signed short
     else:
         raise TypeError("Unknown dtype: {}".format(dtype))
 
@@ -67,6 +87,10 @@ zfp_to_dtype_map = {
     zfp_type_int64: np.int64,
     zfp_type_float: np.float32,
     zfp_type_double: np.float64,
+    zfp_type_half: np.float16,
+    zfp_type_uint8: np.uint8,
+    zfp_type_uint16: np.uint16,
+    zfp_type_int16: np.int16,
 }
 cpdef ztype_to_dtype(zfp_type ztype):
     try:
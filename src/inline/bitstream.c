@@ -95,13 +95,32 @@ The following assumptions and restrictions apply:
    supported only at wsize granularity.  For sequential access, the largest
    possible wsize is preferred due to higher speed.
 
-7. It is up to the user to adhere to these rules.  For performance reasons,
+7. Instead of holding the entire stream, the memory buffer may serve as a
+   bounded window onto a stream whose words are drained to or refilled from
+   a user-supplied callback, e.g., for file I/O.  Such streams are opened via
+   stream_open_sink(buffer, bytes, sink, context) for writing and via
+   stream_open_source(buffer, bytes, source, context) for reading.  Whenever
+   the buffer fills up, its words are passed to the sink, as are any words
+   remaining when the stream is flushed.  Reading past the end of the buffer
+   refills it from the source, and reading past the end of the source yields
+   zero-bits.  Because only the current window is held in memory, callback
+   streams support sequential access only: seeks must stay within the window
+   (or, when reading, move forward), and the stream may be rewound only
+   before any words have been drained or consumed.  Strided access is not
+   supported.  Bit offsets and sizes are measured from the start of the
+   stream rather than the start of the buffer.  A sink that consumes fewer
+   bytes than it is passed puts the stream in a sticky error state, which
+   is reported by stream_error(stream), as does a seek outside the
+   accessible window; such a seek leaves the stream position unchanged.
+
+8. It is up to the user to adhere to these rules.  For performance reasons,
    no error checking is done, and in particular buffer overruns are not
    caught.
 */
 
 #include <limits.h>
 #include <stdlib.h>
+#include <string.h>
 
 #ifndef inline_
   #define inline_
@@ -128,7 +147,12 @@ struct bitstream {
   word buffer; /* buffer for incoming/outgoing bits (buffer < 2^bits) */
   word* ptr;   /* pointer to next word to be read/written */
   word* begin; /* beginning of stream */
-  word* end;   /* end of stream (currently unused) */
+  word* end;   /* end of stream (currently unused for memory streams) */
+  size_t offset;        /* number of words preceding buffer in callback stream */
+  stream_sink sink;     /* callback consuming drained words (or NULL) */
+  stream_source source; /* callback producing refilled words (or NULL) */
+  void* context;        /* user data passed to sink or source */
+  int error;            /* nonzero once sink or seek has failed */
 #ifdef BIT_STREAM_STRIDED
   size_t mask;     /* one less the block size in number of words */
   ptrdiff_t delta; /* number of words between consecutive blocks */
@@ -137,11 +161,38 @@ struct bitstream {
 
 /* private functions ------------------------------------------------------- */
 
+/* pass buffered words to sink and start over at beginning of buffer; once
+   the sink has failed, further words are discarded */
+static void
+stream_drain(bitstream* s)
+{
+  size_t n = (size_t)(s->ptr - s->begin);
+  if (n && !s->error && s->sink(s->begin, n * sizeof(word), s->context) != n * sizeof(word))
+    s->error = 1;
+  s->offset += n;
+  s->ptr = s->begin;
+}
+
+/* refill buffer from source, zero-padding it past the end of the source */
+static void
+stream_refill(bitstream* s)
+{
+  size_t bytes = sizeof(word) * (size_t)(s->end - s->begin);
+  size_t n = s->source(s->begin, bytes, s->context);
+  if (n < bytes)
+    memset((unsigned char*)s->begin + n, 0, bytes - n);
+  s->offset += (size_t)(s->ptr - s->begin);
+  s->ptr = s->begin;
+}
+
 /* read a single word from memory */
 static word
 stream_read_word(bitstream* s)
 {
-  word w = *s->ptr++;
+  word w;
+  if (s->ptr == s->end && s->source)
+    stream_refill(s);
+  w = *s->ptr++;
 #ifdef BIT_STREAM_STRIDED
   if (!((s->ptr - s->begin) & s->mask))
     s->ptr += s->delta;
@@ -158,6 +209,8 @@ stream_write_word(bitstream* s, word value)
   if (!((s->ptr - s->begin) & s->mask))
     s->ptr += s->delta;
 #endif
+  if (s->ptr == s->end && s->sink)
+    stream_drain(s);
 }
 
 /* public functions -------------------------------------------------------- */
@@ -180,7 +233,7 @@ stream_data(const bitstream* s)
 inline_ size_t
 stream_size(const bitstream* s)
 {
-  return sizeof(word) * (size_t)(s->ptr - s->begin);
+  return sizeof(word) * (s->offset + (size_t)(s->ptr - s->begin));
 }
 
 /* byte capacity of stream */
@@ -190,6 +243,20 @@ stream_capacity(const bitstream* s)
   return sizeof(word) * (size_t)(s->end - s->begin);
 }
 
+/* nonzero if sink has failed to consume drained words or seek has failed */
+inline_ int
+stream_error(const bitstream* s)
+{
+  return s->error;
+}
+
+/* nonzero if stream drains to sink or refills from source */
+inline_ int
+stream_is_callback(const bitstream* s)
+{
+  return s->sink || s->source;
+}
+
 /* number of words per block */
 inline_ size_t
 stream_stride_block(const bitstream* s)
@@ -309,14 +376,14 @@ stream_write_bits(bitstream* s, uint64 value, uint n)
 inline_ size_t
 stream_rtell(const bitstream* s)
 {
-  return wsize * (size_t)(s->ptr - s->begin) - s->bits;
+  return wsize * (s->offset + (size_t)(s->ptr - s->begin)) - s->bits;
 }
 
 /* return bit offset to next bit to be written */
 inline_ size_t
 stream_wtell(const bitstream* s)
 {
-  return wsize * (size_t)(s->ptr - s->begin) + s->bits;
+  return wsize * (s->offset + (size_t)(s->ptr - s->begin)) + s->bits;
 }
 
 /* position stream for reading or writing at beginning */
@@ -324,6 +391,7 @@ inline_ void
 stream_rewind(bitstream* s)
 {
   s->ptr = s->begin;
+  s->offset = 0;
   s->buffer = 0;
   s->bits = 0;
 }
@@ -333,7 +401,18 @@ inline_ void
 stream_rseek(bitstream* s, size_t offset)
 {
   uint n = offset % wsize;
-  s->ptr = s->begin + offset / wsize;
+  /* words preceding window of callback stream are no longer accessible */
+  if (offset / wsize < s->offset) {
+    s->error = 1;
+    return;
+  }
+  /* advance window of callback stream until it holds the offset */
+  if (s->source)
+    while (offset / wsize >= s->offset + (size_t)(s->end - s->begin)) {
+      s->ptr = s->end;
+      stream_refill(s);
+    }
+  s->ptr = s->begin + (offset / wsize - s->offset);
   if (n) {
     s->buffer = stream_read_word(s) >> n;
     s->bits = wsize - n;
@@ -349,7 +428,12 @@ inline_ void
 stream_wseek(bitstream* s, size_t offset)
 {
   uint n = offset % wsize;
-  s->ptr = s->begin + offset / wsize;
+  /* seek must stay within window of callback stream */
+  if (s->sink && (offset / wsize < s->offset || offset / wsize >= s->offset + (size_t)(s->end - s->begin))) {
+    s->error = 1;
+    return;
+  }
+  s->ptr = s->begin + (offset / wsize - s->offset);
   if (n) {
     word buffer = *s->ptr;
     buffer &= ((word)1 << n) - 1;
@@ -396,6 +480,8 @@ stream_flush(bitstream* s)
   uint bits = (wsize - s->bits) % wsize;
   if (bits)
     stream_pad(s, bits);
+  if (s->sink)
+    stream_drain(s);
   return bits;
 }
 
@@ -436,6 +522,10 @@ stream_open(void* buffer, size_t bytes)
   if (s) {
     s->begin = (word*)buffer;
     s->end = s->begin + bytes / sizeof(word);
+    s->sink = NULL;
+    s->source = NULL;
+    s->context = NULL;
+    s->error = 0;
 #ifdef BIT_STREAM_STRIDED
     stream_set_stride(s, 0, 0);
 #endif
@@ -444,6 +534,31 @@ stream_open(void* buffer, size_t bytes)
   return s;
 }
 
+/* allocate bit stream that drains user-allocated buffer to sink */
+inline_ bitstream*
+stream_open_sink(void* buffer, size_t bytes, stream_sink sink, void* context)
+{
+  bitstream* s = stream_open(buffer, bytes);
+  if (s) {
+    s->sink = sink;
+    s->context = context;
+  }
+  return s;
+}
+
+/* allocate bit stream that refills user-allocated buffer from source */
+inline_ bitstream*
+stream_open_source(void* buffer, size_t bytes, stream_source source, void* context)
+{
+  bitstream* s = stream_open(buffer, bytes);
+  if (s) {
+    s->source = source;
+    s->context = context;
+    stream_refill(s);
+  }
+  return s;
+}
+
 /* close and deallocate bit stream */
 inline_ void
 stream_close(bitstream* s)
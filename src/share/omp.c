@@ -27,4 +27,18 @@ chunk_count_omp(const zfp_stream* stream, size_t blocks, uint threads)
   return chunks;
 }
 
+/* concatenate per-thread streams, merging whole words in parallel */
+static void
+compress_finish_omp(zfp_stream* stream, bitstream** bs, size_t chunks, uint threads)
+{
+  zfp_bool copy = compress_layout_par(stream, bs, chunks);
+  if (copy) {
+    int chunk; /* OpenMP 2.0 requires int loop counter */
+    #pragma omp parallel for num_threads(threads)
+    for (chunk = 0; chunk < (int)chunks; chunk++)
+      compress_merge_par(bs, chunks, chunk);
+  }
+  compress_finish_par(stream, bs, chunks, copy);
+}
+
 #endif
@@ -1,5 +1,3 @@
-#ifdef _OPENMP
-
 /* block index at which chunk begins */
 static size_t
 chunk_offset(size_t blocks, size_t chunks, size_t chunk)
@@ -7,6 +5,45 @@ chunk_offset(size_t blocks, size_t chunks, size_t chunk)
   return (size_t)(((uint64)blocks * (uint64)chunk) / chunks);
 }
 
+#if defined(_OPENMP) || defined(ZFP_WITH_THREADS)
+
+/* byte offset of chunk buffers in scratch memory, which holds per-chunk
+   streams for encoding and for merging, followed by per-chunk bit offsets */
+static size_t
+scratch_offset(size_t chunks)
+{
+  size_t bytes = 2 * chunks * sizeof(bitstream*) + (chunks + 1) * sizeof(size_t);
+  return (bytes + sizeof(uint64) - 1) & ~(sizeof(uint64) - 1);
+}
+
+/* bit offsets of chunks within output stream, stored after per-chunk streams */
+static size_t*
+chunk_offsets(bitstream** bs, size_t chunks)
+{
+  return (size_t*)(bs + 2 * chunks);
+}
+
+/* number of leading bits of chunk that share a word with preceding output */
+static size_t
+chunk_head(size_t offset, size_t bits)
+{
+  size_t head = (stream_word_bits - offset % stream_word_bits) % stream_word_bits;
+  return MIN(head, bits);
+}
+
+/* return stream's scratch memory after growing it to at least size bytes */
+static void*
+scratch_reserve(zfp_stream* stream, size_t size)
+{
+  if (stream->scratch_size < size) {
+    /* contents need not be preserved, so avoid realloc's copy */
+    free(stream->scratch);
+    stream->scratch = malloc(size);
+    stream->scratch_size = stream->scratch ? size : 0;
+  }
+  return stream->scratch;
+}
+
 /* initialize per-thread bit streams for parallel compression */
 static bitstream**
 compress_init_par(zfp_stream* stream, const zfp_field* field, size_t chunks, size_t blocks)
@@ -14,11 +51,19 @@ compress_init_par(zfp_stream* stream, const zfp_field* field, size_t chunks, siz
   bitstream** bs;
   zfp_bool copy;
   size_t n = 4 * (blocks + chunks - 1) / chunks;
+  size_t offset = scratch_offset(chunks);
   size_t size;
   size_t chunk;
+  uchar* scratch;
 
   /* determine maximum size buffer needed per thread */
   zfp_field f = *field;
+
+  /* threads need random access to the whole stream, which callback streams
+     do not provide */
+  if (stream_is_callback(stream->stream))
+    return NULL;
+
   switch (zfp_field_dimensionality(field)) {
     case 1:
       f.nx = n;
@@ -46,59 +91,204 @@ compress_init_par(zfp_stream* stream, const zfp_field* field, size_t chunks, siz
   /* avoid copies in fixed-rate mode when each bitstream is word aligned */
   copy = (stream->minbits != stream->maxbits) ||
          (stream->maxbits % stream_word_bits != 0) ||
-         (stream_wtell(stream->stream) % stream_word_bits != 0);
+         (!stream->chunk_index && stream_wtell(stream->stream) % stream_word_bits != 0);
 
-  /* set up buffer for each thread to compress to */
-  bs = (bitstream**)malloc(chunks * sizeof(bitstream*));
-  if (!bs)
+  /* carve per-thread streams and, if needed, buffers out of scratch memory */
+  scratch = (uchar*)scratch_reserve(stream, offset + (copy ? chunks * size : 0));
+  if (!scratch)
     return NULL;
+  bs = (bitstream**)scratch;
+
+  /* chunk offsets are known up front when compressing in place */
+  if (!copy && stream->chunk_index) {
+    chunk_index_begin(stream->stream, chunks);
+    for (chunk = 0; chunk < chunks; chunk++)
+      chunk_index_append(stream->stream, (uint64)chunk_offset(blocks, chunks, chunk) * stream->maxbits);
+  }
+
+  /* set up buffer for each thread to compress to and, when copying, a
+     stream for merging the chunk into the output stream */
   for (chunk = 0; chunk < chunks; chunk++) {
     size_t block = chunk_offset(blocks, chunks, chunk);
-    void* buffer = copy ? malloc(size) : (uchar*)stream_data(stream->stream) + stream_size(stream->stream) + block * (stream->maxbits / CHAR_BIT);
-    if (!buffer)
-      break;
+    void* buffer = copy ? scratch + offset + chunk * size : (uchar*)stream_data(stream->stream) + stream_size(stream->stream) + block * (stream->maxbits / CHAR_BIT);
     bs[chunk] = stream_open(buffer, size);
+    if (!bs[chunk])
+      break;
+    bs[chunks + chunk] = copy ? stream_open(stream_data(stream->stream), stream_capacity(stream->stream)) : NULL;
+    if (copy && !bs[chunks + chunk]) {
+      stream_close(bs[chunk]);
+      break;
+    }
   }
 
   /* handle memory allocation failure */
-  if (copy && chunk < chunks) {
+  if (chunk < chunks) {
     while (chunk--) {
-      free(stream_data(bs[chunk]));
       stream_close(bs[chunk]);
+      if (copy)
+        stream_close(bs[chunks + chunk]);
     }
-    free(bs);
     bs = NULL;
   }
 
   return bs;
 }
 
-/* flush and concatenate bit streams if needed */
-static void
-compress_finish_par(zfp_stream* stream, bitstream** src, size_t chunks)
+/* flush per-thread streams and determine where each chunk goes in output
+   stream; return whether chunks need to be merged into output stream */
+static zfp_bool
+compress_layout_par(zfp_stream* stream, bitstream** src, size_t chunks)
 {
   bitstream* dst = zfp_stream_bit_stream(stream);
-  zfp_bool copy = (stream_data(dst) != stream_data(*src));
-  size_t offset = stream_wtell(dst);
+  zfp_bool copy = ((uchar*)stream_data(dst) + stream_size(dst) != stream_data(*src));
+  size_t* offset = chunk_offsets(src, chunks);
   size_t chunk;
 
-  /* flush each stream and concatenate if necessary */
+  /* record chunk offsets before concatenating streams */
+  if (copy && stream->chunk_index) {
+    uint64 bits = 0;
+    chunk_index_begin(dst, chunks);
+    for (chunk = 0; chunk < chunks; chunk++) {
+      chunk_index_append(dst, bits);
+      bits += stream_wtell(src[chunk]);
+    }
+  }
+
+  /* compute bit offset of each chunk from exact chunk sizes */
+  offset[0] = stream_wtell(dst);
   for (chunk = 0; chunk < chunks; chunk++) {
-    size_t bits = stream_wtell(src[chunk]);
-    offset += bits;
+    offset[chunk + 1] = offset[chunk] + stream_wtell(src[chunk]);
     stream_flush(src[chunk]);
-    /* concatenate streams if they are not already contiguous */
+  }
+
+  return copy;
+}
+
+/* copy words of chunk not shared with other chunks to their final position
+   in output stream; may be called concurrently for distinct chunks */
+static void
+compress_merge_par(bitstream** src, size_t chunks, size_t chunk)
+{
+  const size_t* offset = chunk_offsets(src, chunks);
+  size_t bits = offset[chunk + 1] - offset[chunk];
+  size_t head = chunk_head(offset[chunk], bits);
+  size_t body = (bits - head) & ~(stream_word_bits - 1);
+
+  /* funnel shift whole words starting at a word boundary in output */
+  if (body) {
+    bitstream* dst = src[chunks + chunk];
+    stream_rseek(src[chunk], head);
+    stream_wseek(dst, offset[chunk] + head);
+    stream_copy(dst, src[chunk], body);
+  }
+}
+
+/* complete concatenation of merged streams by copying partial words at chunk
+   boundaries, and deallocate per-thread streams */
+static void
+compress_finish_par(zfp_stream* stream, bitstream** src, size_t chunks, zfp_bool copy)
+{
+  bitstream* dst = zfp_stream_bit_stream(stream);
+  const size_t* offset = chunk_offsets(src, chunks);
+  size_t chunk;
+
+  for (chunk = 0; chunk < chunks; chunk++) {
     if (copy) {
+      size_t bits = offset[chunk + 1] - offset[chunk];
+      size_t head = chunk_head(offset[chunk], bits);
+      size_t body = (bits - head) & ~(stream_word_bits - 1);
+      /* complete word shared with preceding chunk */
       stream_rewind(src[chunk]);
-      stream_copy(dst, src[chunk], bits);
-      free(stream_data(src[chunk]));
+      stream_copy(dst, src[chunk], head);
+      /* skip over merged words and start word shared with next chunk */
+      if (body) {
+        stream_rseek(src[chunk], head + body);
+        stream_wseek(dst, offset[chunk] + head + body);
+      }
+      stream_copy(dst, src[chunk], bits - head - body);
+      stream_close(src[chunks + chunk]);
     }
     stream_close(src[chunk]);
   }
 
-  free(src);
   if (!copy)
-    stream_wseek(dst, offset);
+    stream_wseek(dst, offset[chunks]);
+}
+
+/* initialize per-thread bit streams for parallel decompression; the number
+   of chunks is dictated by the chunk index when present; return NULL if the
+   chunk index is corrupt or memory cannot be allocated */
+static bitstream**
+decompress_init_par(zfp_stream* stream, size_t* chunks, size_t blocks)
+{
+  size_t bits = stream_capacity(stream->stream) * CHAR_BIT;
+  uint64 prev = 0;
+  bitstream** bs;
+  size_t offset;
+  size_t chunk;
+
+  /* threads need random access to the whole stream, which callback streams
+     do not provide */
+  if (stream_is_callback(stream->stream))
+    return NULL;
+
+  /* read number of chunks and skip to first chunk offset */
+  if (stream->chunk_index) {
+    *chunks = chunk_index_read_count(stream->stream, blocks);
+    if (!*chunks)
+      return NULL;
+  }
+  offset = stream_rtell(stream->stream);
+  if (stream->chunk_index)
+    offset += 64 * *chunks;
+
+  /* set up read-only view of shared buffer for each thread */
+  bs = (bitstream**)scratch_reserve(stream, scratch_offset(*chunks));
+  if (!bs)
+    return NULL;
+  for (chunk = 0; chunk < *chunks; chunk++) {
+    uint64 begin;
+    if (stream->chunk_index) {
+      /* chunks must begin within stream and follow one another */
+      if (!chunk_index_read_offset(stream->stream, &begin, prev, bits - offset))
+        break;
+      prev = begin;
+    }
+    else {
+      /* each block occupies exactly maxbits bits */
+      size_t block = chunk_offset(blocks, *chunks, chunk);
+      begin = (uint64)block * stream->maxbits;
+      if (begin > bits - offset)
+        break;
+    }
+    bs[chunk] = stream_clone(stream->stream);
+    if (!bs[chunk])
+      break;
+    stream_rseek(bs[chunk], offset + (size_t)begin);
+  }
+
+  /* handle corrupt chunk index or memory allocation failure */
+  if (chunk < *chunks) {
+    while (chunk--)
+      stream_close(bs[chunk]);
+    bs = NULL;
+  }
+
+  return bs;
+}
+
+/* deallocate per-thread bit streams and position stream past last block */
+static void
+decompress_finish_par(zfp_stream* stream, bitstream** src, size_t chunks)
+{
+  bitstream* dst = zfp_stream_bit_stream(stream);
+  size_t offset = stream_rtell(src[chunks - 1]);
+  size_t chunk;
+
+  for (chunk = 0; chunk < chunks; chunk++)
+    stream_close(src[chunk]);
+
+  stream_rseek(dst, offset);
 }
 
 #endif
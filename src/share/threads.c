@@ -0,0 +1,270 @@
+#ifdef ZFP_WITH_THREADS
+#include <limits.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/* parallel (de)compression job shared by all participating threads */
+typedef struct {
+  zfp_stream* stream;     /* compressed stream */
+  const zfp_field* field; /* uncompressed array */
+  bitstream** bs;         /* per-chunk bit streams */
+  size_t blocks;          /* number of blocks in array */
+  size_t chunks;          /* number of chunks of blocks */
+} threads_job;
+
+/* work posted to the pool by one call; lives on the caller's stack */
+typedef struct thread_pool_task {
+  struct thread_pool_task* next_task; /* next posted task */
+  void (*run)(void*, size_t);         /* function that processes one chunk */
+  void* arg;                          /* job argument passed to run */
+  size_t chunks;                      /* number of chunks in task */
+  size_t next;                        /* index of next chunk to claim */
+  uint workers;                       /* max number of workers that may help */
+  uint active;                        /* number of workers executing task */
+} thread_pool_task;
+
+/* persistent pool of worker threads shared by all zfp streams; concurrent
+   calls post independent tasks that idle workers help process */
+static struct {
+  pthread_mutex_t lock;    /* protects all members below and posted tasks */
+  pthread_cond_t wake;     /* signals workers that a task is posted */
+  pthread_cond_t done;     /* signals submitters that workers left a task */
+  pthread_t* thread;       /* worker threads */
+  uint size;               /* number of worker threads */
+  zfp_bool exit;           /* are workers asked to terminate? */
+  zfp_bool registered;     /* is thread_pool_shutdown registered? */
+  thread_pool_task* tasks; /* tasks with chunks possibly left to claim */
+} pool = {
+  PTHREAD_MUTEX_INITIALIZER,
+  PTHREAD_COND_INITIALIZER,
+  PTHREAD_COND_INITIALIZER,
+  NULL, 0, zfp_false, zfp_false, NULL
+};
+
+/* claim and process chunks of task until none remain (pool.lock held) */
+static void
+thread_pool_drain(thread_pool_task* task)
+{
+  while (task->next < task->chunks) {
+    size_t chunk = task->next++;
+    pthread_mutex_unlock(&pool.lock);
+    task->run(task->arg, chunk);
+    pthread_mutex_lock(&pool.lock);
+  }
+}
+
+/* posted task that an idle worker may help with, if any (pool.lock held) */
+static thread_pool_task*
+thread_pool_claim(void)
+{
+  thread_pool_task* task;
+  for (task = pool.tasks; task; task = task->next_task)
+    if (task->next < task->chunks && task->active < task->workers)
+      return task;
+  return NULL;
+}
+
+/* worker thread main loop */
+static void*
+thread_pool_worker(void* arg)
+{
+  (void)arg;
+  pthread_mutex_lock(&pool.lock);
+  for (;;) {
+    thread_pool_task* task = NULL;
+    while (!pool.exit && !(task = thread_pool_claim()))
+      pthread_cond_wait(&pool.wake, &pool.lock);
+    if (pool.exit)
+      break;
+    task->active++;
+    thread_pool_drain(task);
+    if (!--task->active)
+      pthread_cond_broadcast(&pool.done);
+  }
+  pthread_mutex_unlock(&pool.lock);
+  return NULL;
+}
+
+/* terminate and join idle worker threads; called at process exit */
+static void
+thread_pool_shutdown(void)
+{
+  uint i;
+
+  pthread_mutex_lock(&pool.lock);
+  pool.exit = zfp_true;
+  pthread_cond_broadcast(&pool.wake);
+  pthread_mutex_unlock(&pool.lock);
+
+  for (i = 0; i < pool.size; i++)
+    pthread_join(pool.thread[i], NULL);
+  free(pool.thread);
+
+  pthread_mutex_lock(&pool.lock);
+  pool.thread = NULL;
+  pool.size = 0;
+  pool.exit = zfp_false;
+  pthread_mutex_unlock(&pool.lock);
+}
+
+/* grow pool to at least the given number of workers (pool.lock held) */
+static void
+thread_pool_grow(uint workers)
+{
+  pthread_t* thread;
+
+  if (pool.size >= workers)
+    return;
+  if (!pool.registered) {
+    if (atexit(thread_pool_shutdown))
+      return;
+    pool.registered = zfp_true;
+  }
+  thread = (pthread_t*)realloc(pool.thread, workers * sizeof(pthread_t));
+  if (!thread)
+    return;
+  pool.thread = thread;
+  while (pool.size < workers && !pthread_create(&pool.thread[pool.size], NULL, thread_pool_worker, NULL))
+    pool.size++;
+}
+
+/* process chunks [0, chunks) using up to the given number of threads; may be
+   called concurrently and from within run, since the caller always drains
+   its own task and workers only assist */
+static void
+thread_pool_run(uint threads, size_t chunks, void (*run)(void*, size_t), void* arg)
+{
+  thread_pool_task task;
+  thread_pool_task** link;
+
+  pthread_mutex_lock(&pool.lock);
+
+  /* grow pool on demand; the calling thread is itself one of the threads */
+  task.workers = (uint)MIN(threads - 1, chunks - 1);
+  thread_pool_grow(task.workers);
+
+  /* post task and let idle workers claim chunks as they become available */
+  task.run = run;
+  task.arg = arg;
+  task.chunks = chunks;
+  task.next = 0;
+  task.active = 0;
+  task.next_task = pool.tasks;
+  pool.tasks = &task;
+  if (task.workers && pool.size)
+    pthread_cond_broadcast(&pool.wake);
+  thread_pool_drain(&task);
+
+  /* withdraw task and wait for workers still processing its chunks */
+  for (link = &pool.tasks; *link != &task; link = &(*link)->next_task)
+    ;
+  *link = task.next_task;
+  while (task.active)
+    pthread_cond_wait(&pool.done, &pool.lock);
+
+  pthread_mutex_unlock(&pool.lock);
+}
+
+/* number of threads to use */
+static uint
+thread_count_threads(const zfp_stream* stream)
+{
+  uint count = stream->exec.params.threads.threads;
+  /* if no thread count is specified, use one thread per online processor */
+  if (!count) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    count = cpus > 0 ? (uint)cpus : 1;
+  }
+  return count;
+}
+
+/* number of chunks to partition array into */
+static size_t
+chunk_count_threads(const zfp_stream* stream, size_t blocks, uint threads)
+{
+  size_t chunk_size = stream->exec.params.threads.chunk_size;
+  /* if no chunk size is specified, assign one chunk per thread */
+  size_t chunks = chunk_size ? (blocks + chunk_size - 1) / chunk_size : threads;
+  /* each chunk must contain at least one block */
+  chunks = MIN(chunks, blocks);
+  /* chunk index supports at most INT_MAX chunks */
+  chunks = MIN(chunks, INT_MAX);
+  return chunks;
+}
+
+/* number of blocks in array */
+static size_t
+block_count_threads(const zfp_field* field)
+{
+  size_t bx = (MAX(field->nx, 1u) + 3) / 4;
+  size_t by = (MAX(field->ny, 1u) + 3) / 4;
+  size_t bz = (MAX(field->nz, 1u) + 3) / 4;
+  size_t bw = (MAX(field->nw, 1u) + 3) / 4;
+  return bx * by * bz * bw;
+}
+
+/* merge chunk of compressed blocks into output stream */
+static void
+merge_chunk_threads(void* arg, size_t chunk)
+{
+  const threads_job* job = (const threads_job*)arg;
+  compress_merge_par(job->bs, job->chunks, chunk);
+}
+
+/* compress array in parallel by applying run to each chunk of blocks */
+static void
+compress_threads(zfp_stream* stream, const zfp_field* field, void (*run)(void*, size_t))
+{
+  uint threads = thread_count_threads(stream);
+  threads_job job;
+  zfp_bool copy;
+
+  job.stream = stream;
+  job.field = field;
+  job.blocks = block_count_threads(field);
+  job.chunks = chunk_count_threads(stream, job.blocks, threads);
+
+  /* allocate per-chunk streams */
+  job.bs = compress_init_par(stream, field, job.chunks, job.blocks);
+  if (!job.bs)
+    return;
+
+  /* compress chunks of blocks in parallel */
+  thread_pool_run(threads, job.chunks, run, &job);
+
+  /* concatenate per-chunk streams, merging whole words in parallel */
+  copy = compress_layout_par(stream, job.bs, job.chunks);
+  if (copy)
+    thread_pool_run(threads, job.chunks, merge_chunk_threads, &job);
+  compress_finish_par(stream, job.bs, job.chunks, copy);
+}
+
+/* decompress array in parallel by applying run to each chunk of blocks;
+   return false on failure */
+static zfp_bool
+decompress_threads(zfp_stream* stream, const zfp_field* field, void (*run)(void*, size_t))
+{
+  uint threads = thread_count_threads(stream);
+  threads_job job;
+
+  job.stream = stream;
+  job.field = field;
+  job.blocks = block_count_threads(field);
+  job.chunks = chunk_count_threads(stream, job.blocks, threads);
+
+  /* allocate per-chunk streams */
+  job.bs = decompress_init_par(stream, &job.chunks, job.blocks);
+  if (!job.bs)
+    return zfp_false;
+
+  /* decompress chunks of blocks in parallel */
+  thread_pool_run(threads, job.chunks, run, &job);
+
+  /* advance stream past decompressed blocks */
+  decompress_finish_par(stream, job.bs, job.chunks);
+
+  return zfp_true;
+}
+
+#endif
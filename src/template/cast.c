@@ -0,0 +1,17 @@
+/* conversions between single and double precision */
+
+/* private functions ------------------------------------------------------- */
+
+/* convert value to type it is (de)compressed as */
+static Codec
+_t1(fwd_convert, Scalar)(Scalar x)
+{
+  return (Codec)x;
+}
+
+/* convert decompressed value to array type */
+static Scalar
+_t1(inv_convert, Scalar)(Codec x)
+{
+  return (Scalar)x;
+}
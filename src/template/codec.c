@@ -4,3 +4,21 @@ with_maxbits(uint maxbits, uint maxprec, uint size)
 {
   return (maxprec + 1) * size - 1 > maxbits;
 }
+
+/* number of trailing zero-bits in x != 0 */
+static uint
+trailing_zeros(uint64 x)
+{
+#if defined(__GNUC__)
+  return (uint)__builtin_ctzll(x);
+#else
+  /* isolate lowest one-bit and look up its position via de Bruijn sequence */
+  static const uchar table[64] = {
+     0,  1,  2, 53,  3,  7, 54, 27,  4, 38, 41,  8, 34, 55, 48, 28,
+    62,  5, 39, 46, 44, 42, 22,  9, 24, 35, 59, 56, 49, 18, 29, 11,
+    63, 52,  6, 26, 37, 40, 33, 47, 61, 45, 43, 21, 23, 58, 17, 10,
+    51, 25, 36, 32, 60, 20, 57, 16, 50, 31, 19, 15, 30, 14, 13, 12,
+  };
+  return table[((x & (~x + 1)) * UINT64C(0x022fdd63cc95386d)) >> 58];
+#endif
+}
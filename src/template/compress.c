@@ -107,3 +107,143 @@ _t2(compress_strided, Scalar, 4)(zfp_stream* stream, const zfp_field* field)
             _t2(zfp_encode_block_strided, Scalar, 4)(stream, p, sx, sy, sz, sw);
         }
 }
+
+/* gather m[0]*m[1]*m[2]*m[3] block of nc interleaved components into nc
+   consecutive blocks of bs values each */
+static void
+_t1(gather_components, Scalar)(Scalar* q, const Scalar* p, uint nc, uint bs, const size_t* m, const ptrdiff_t* s)
+{
+  size_t x, y, z, w;
+  uint c;
+  for (w = 0; w < m[3]; w++, p += s[3] - (ptrdiff_t)m[2] * s[2])
+    for (z = 0; z < m[2]; z++, p += s[2] - (ptrdiff_t)m[1] * s[1])
+      for (y = 0; y < m[1]; y++, p += s[1] - (ptrdiff_t)m[0] * s[0]) {
+        Scalar* r = q + 64 * w + 16 * z + 4 * y;
+        if (m[0] == 4)
+          for (c = 0; c < nc; c++, r += bs) {
+            r[0] = p[c];
+            r[1] = p[c + s[0]];
+            r[2] = p[c + 2 * s[0]];
+            r[3] = p[c + 3 * s[0]];
+          }
+        else
+          for (c = 0; c < nc; c++, r += bs)
+            for (x = 0; x < m[0]; x++)
+              r[x] = p[c + (ptrdiff_t)x * s[0]];
+        p += (ptrdiff_t)m[0] * s[0];
+      }
+}
+
+/* encode contiguous, possibly partial, block of given dimensionality */
+static void
+_t1(encode_component, Scalar)(zfp_stream* stream, const Scalar* block, uint dims, const size_t* m)
+{
+  zfp_bool partial = m[0] < 4 || (dims > 1 && m[1] < 4) || (dims > 2 && m[2] < 4) || (dims > 3 && m[3] < 4);
+  switch (dims) {
+    case 1:
+      if (partial)
+        _t2(zfp_encode_partial_block_strided, Scalar, 1)(stream, block, m[0], 1);
+      else
+        _t2(zfp_encode_block, Scalar, 1)(stream, block);
+      break;
+    case 2:
+      if (partial)
+        _t2(zfp_encode_partial_block_strided, Scalar, 2)(stream, block, m[0], m[1], 1, 4);
+      else
+        _t2(zfp_encode_block, Scalar, 2)(stream, block);
+      break;
+    case 3:
+      if (partial)
+        _t2(zfp_encode_partial_block_strided, Scalar, 3)(stream, block, m[0], m[1], m[2], 1, 4, 16);
+      else
+        _t2(zfp_encode_block, Scalar, 3)(stream, block);
+      break;
+    case 4:
+      if (partial)
+        _t2(zfp_encode_partial_block_strided, Scalar, 4)(stream, block, m[0], m[1], m[2], m[3], 1, 4, 16, 64);
+      else
+        _t2(zfp_encode_block, Scalar, 4)(stream, block);
+      break;
+  }
+}
+
+/* compress array of interleaved components, gathering all components of
+   each block in one pass and encoding them as consecutive blocks */
+static void
+_t1(compress_components, Scalar)(zfp_stream* stream, const zfp_field* field)
+{
+  const Scalar* data = (const Scalar*)field->data;
+  uint dims = zfp_field_dimensionality(field);
+  uint nc = zfp_field_components(field);
+  uint bs = 1u << (2 * dims);
+  cache_align_(Scalar block[ZFP_MAX_COMPONENTS * 256]);
+  ptrdiff_t s[4] = { 0, 0, 0, 0 };
+  size_t nx = field->nx;
+  size_t ny = MAX(field->ny, 1u);
+  size_t nz = MAX(field->nz, 1u);
+  size_t nw = MAX(field->nw, 1u);
+  size_t x, y, z, w;
+  uint c;
+
+  zfp_field_stride(field, s);
+  for (w = 0; w < nw; w += 4)
+    for (z = 0; z < nz; z += 4)
+      for (y = 0; y < ny; y += 4)
+        for (x = 0; x < nx; x += 4) {
+          const Scalar* p = data + s[0] * (ptrdiff_t)x + s[1] * (ptrdiff_t)y + s[2] * (ptrdiff_t)z + s[3] * (ptrdiff_t)w;
+          size_t m[4];
+          m[0] = MIN(nx - x, 4u);
+          m[1] = MIN(ny - y, 4u);
+          m[2] = MIN(nz - z, 4u);
+          m[3] = MIN(nw - w, 4u);
+          _t1(gather_components, Scalar)(block, p, nc, bs, m, s);
+          for (c = 0; c < nc; c++)
+            _t1(encode_component, Scalar)(stream, block + c * bs, dims, m);
+        }
+}
+
+/* compress block with given index within array and return its bit count */
+static size_t
+_t1(compress_block_index, Scalar)(zfp_stream* stream, const zfp_field* field, size_t index)
+{
+  const Scalar* p = (const Scalar*)field->data;
+  uint dims = zfp_field_dimensionality(field);
+  ptrdiff_t s[4] = { 0, 0, 0, 0 };
+  size_t n[4], m[4];
+  uint i;
+
+  /* locate block and determine its extent, which may be partial */
+  n[0] = field->nx;
+  n[1] = field->ny;
+  n[2] = field->nz;
+  n[3] = field->nw;
+  zfp_field_stride(field, s);
+  for (i = 0; i < dims; i++) {
+    size_t blocks = (n[i] + 3) / 4;
+    size_t x = 4 * (index % blocks);
+    index /= blocks;
+    p += s[i] * (ptrdiff_t)x;
+    m[i] = MIN(n[i] - x, 4u);
+  }
+
+  switch (dims) {
+    case 1:
+      return m[0] < 4
+        ? _t2(zfp_encode_partial_block_strided, Scalar, 1)(stream, p, m[0], s[0])
+        : _t2(zfp_encode_block_strided, Scalar, 1)(stream, p, s[0]);
+    case 2:
+      return m[0] < 4 || m[1] < 4
+        ? _t2(zfp_encode_partial_block_strided, Scalar, 2)(stream, p, m[0], m[1], s[0], s[1])
+        : _t2(zfp_encode_block_strided, Scalar, 2)(stream, p, s[0], s[1]);
+    case 3:
+      return m[0] < 4 || m[1] < 4 || m[2] < 4
+        ? _t2(zfp_encode_partial_block_strided, Scalar, 3)(stream, p, m[0], m[1], m[2], s[0], s[1], s[2])
+        : _t2(zfp_encode_block_strided, Scalar, 3)(stream, p, s[0], s[1], s[2]);
+    case 4:
+      return m[0] < 4 || m[1] < 4 || m[2] < 4 || m[3] < 4
+        ? _t2(zfp_encode_partial_block_strided, Scalar, 4)(stream, p, m[0], m[1], m[2], m[3], s[0], s[1], s[2], s[3])
+        : _t2(zfp_encode_block_strided, Scalar, 4)(stream, p, s[0], s[1], s[2], s[3]);
+    default:
+      return 0;
+  }
+}
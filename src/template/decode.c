@@ -64,6 +64,41 @@ _t1(inv_order, Int)(const UInt* ublock, Int* iblock, const uchar* perm, uint n)
   while (--n);
 }
 
+/* read up to n bits through the first one-bit; return number of zero-bits */
+static uint
+read_zeros(bitstream* s, uint n)
+{
+  uint z = 0;
+  while (z < n) {
+    uint i;
+    if (!s->bits) {
+      s->buffer = stream_read_word(s);
+      s->bits = wsize;
+    }
+    /* buffered bits above s->bits are zero */
+    i = s->buffer ? trailing_zeros(s->buffer) : s->bits;
+    if (i >= n - z) {
+      /* run of zeros extends past n bits; consume only those */
+      i = n - z;
+      s->bits -= i;
+      s->buffer >>= i - 1;
+      s->buffer >>= 1;
+      return n;
+    }
+    if (i < s->bits) {
+      /* consume zeros and terminating one-bit */
+      s->bits -= i + 1;
+      s->buffer >>= i;
+      s->buffer >>= 1;
+      return z + i;
+    }
+    /* remaining buffered bits are all zero */
+    z += i;
+    s->bits = 0;
+  }
+  return z;
+}
+
 /* decompress sequence of size <= 64 unsigned integers */
 static uint
 _t1(decode_few_ints, UInt)(bitstream* restrict_ stream, uint maxbits, uint maxprec, UInt* restrict_ data, uint size)
@@ -91,11 +126,10 @@ _t1(decode_few_ints, UInt)(bitstream* restrict_ stream, uint maxbits, uint maxpr
       bits--;
       if (stream_read_bit(&s)) {
         /* positive group test; scan for next one-bit */
-        for (; bits && n < size - 1; n++) {
-          bits--;
-          if (stream_read_bit(&s))
-            break;
-        }
+        m = MIN(bits, size - 1 - n);
+        i = read_zeros(&s, m);
+        bits -= i < m ? i + 1 : i;
+        n += i;
         /* set bit and continue decoding bit plane */
         x += (uint64)1 << n;
       }
@@ -105,9 +139,9 @@ _t1(decode_few_ints, UInt)(bitstream* restrict_ stream, uint maxbits, uint maxpr
         break;
       }
     }
-    /* step 3: deposit bit plane from x */
-    for (i = 0; x; i++, x >>= 1)
-      data[i] += (UInt)(x & 1u) << k;
+    /* step 3: deposit bit plane from x, visiting only its one-bits */
+    for (; x; x &= x - 1)
+      data[trailing_zeros(x)] += (UInt)1 << k;
   }
 
 #if ZFP_ROUNDING_MODE == ZFP_ROUND_LAST
@@ -193,11 +227,10 @@ _t1(decode_few_ints_prec, UInt)(bitstream* restrict_ stream, uint maxprec, UInt*
     uint64 x = stream_read_bits(&s, n);
     /* step 2: unary run-length decode remainder of bit plane */
     for (; n < size && stream_read_bit(&s); x += (uint64)1 << n, n++)
-      for (; n < size - 1 && !stream_read_bit(&s); n++)
-        ;
-    /* step 3: deposit bit plane from x */
-    for (i = 0; x; i++, x >>= 1)
-      data[i] += (UInt)(x & 1u) << k;
+      n += read_zeros(&s, size - 1 - n);
+    /* step 3: deposit bit plane from x, visiting only its one-bits */
+    for (; x; x &= x - 1)
+      data[trailing_zeros(x)] += (UInt)1 << k;
   }
 
 #if ZFP_ROUNDING_MODE == ZFP_ROUND_LAST
@@ -266,9 +299,9 @@ _t1(decode_ints, UInt)(bitstream* restrict_ stream, uint maxbits, uint maxprec,
   }
 }
 
-/* decode block of integers */
+/* decode block of transform coefficients */
 static uint
-_t2(decode_block, Int, DIMS)(bitstream* stream, int minbits, int maxbits, int maxprec, Int* iblock)
+_t2(decode_coefficients, Int, DIMS)(bitstream* stream, int minbits, int maxbits, int maxprec, Int* iblock)
 {
   int bits;
   cache_align_(UInt ublock[BLOCK_SIZE]);
@@ -281,6 +314,15 @@ _t2(decode_block, Int, DIMS)(bitstream* stream, int minbits, int maxbits, int ma
   }
   /* reorder unsigned coefficients and convert to signed integer */
   _t1(inv_order, Int)(ublock, iblock, PERM, BLOCK_SIZE);
+  return bits;
+}
+
+/* decode block of integers */
+static uint
+_t2(decode_block, Int, DIMS)(bitstream* stream, int minbits, int maxbits, int maxprec, Int* iblock)
+{
+  /* decode transform coefficients */
+  uint bits = _t2(decode_coefficients, Int, DIMS)(stream, minbits, maxbits, maxprec, iblock);
   /* perform decorrelating transform */
   _t2(inv_xform, Int, DIMS)(iblock);
   return bits;
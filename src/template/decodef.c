@@ -41,3 +41,58 @@ _t2(zfp_decode_block, Scalar, DIMS)(zfp_stream* zfp, Scalar* fblock)
 {
   return REVERSIBLE(zfp) ? _t2(rev_decode_block, Scalar, DIMS)(zfp, fblock) : _t2(decode_block, Scalar, DIMS)(zfp, fblock);
 }
+
+/* decode block of transform coefficients and their common exponent */
+size_t
+_t2(zfp_decode_coefficients, Scalar, DIMS)(zfp_stream* zfp, Int* coeff, int* emax)
+{
+  uint bits = 1;
+  /* coefficients are entropy coded only in lossy modes */
+  if (REVERSIBLE(zfp))
+    return 0;
+  /* test if block has nonzero values */
+  if (stream_read_bit(zfp->stream)) {
+    int maxprec;
+    /* decode common exponent */
+    bits += EBITS;
+    *emax = (int)stream_read_bits(zfp->stream, EBITS) - EBIAS;
+    maxprec = precision(*emax, zfp->maxprec, zfp->minexp, DIMS);
+    /* decode transform coefficients */
+    bits += _t2(decode_coefficients, Int, DIMS)(zfp->stream, zfp->minbits - bits, zfp->maxbits - bits, maxprec, coeff);
+  }
+  else {
+    /* set all coefficients to zero */
+    uint i;
+    for (i = 0; i < BLOCK_SIZE; i++)
+      coeff[i] = 0;
+    *emax = -EBIAS;
+    if (zfp->minbits > bits) {
+      stream_skip(zfp->stream, zfp->minbits - bits);
+      bits = zfp->minbits;
+    }
+  }
+  return bits;
+}
+
+/* decode count contiguous floating-point blocks stored back to back */
+size_t
+_t2(zfp_decode_blocks, Scalar, DIMS)(zfp_stream* zfp, Scalar* fblock, size_t count, size_t* offset)
+{
+  size_t base = offset ? stream_rtell(zfp->stream) : 0;
+  size_t bits = 0;
+  size_t i;
+  /* hoist mode dispatch out of loop over blocks */
+  if (REVERSIBLE(zfp))
+    for (i = 0; i < count; i++, fblock += BLOCK_SIZE) {
+      if (offset)
+        offset[i] = base + bits;
+      bits += _t2(rev_decode_block, Scalar, DIMS)(zfp, fblock);
+    }
+  else
+    for (i = 0; i < count; i++, fblock += BLOCK_SIZE) {
+      if (offset)
+        offset[i] = base + bits;
+      bits += _t2(decode_block, Scalar, DIMS)(zfp, fblock);
+    }
+  return bits;
+}
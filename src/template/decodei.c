@@ -8,3 +8,26 @@ _t2(zfp_decode_block, Int, DIMS)(zfp_stream* zfp, Int* iblock)
 {
   return REVERSIBLE(zfp) ? _t2(rev_decode_block, Int, DIMS)(zfp->stream, zfp->minbits, zfp->maxbits, iblock) : _t2(decode_block, Int, DIMS)(zfp->stream, zfp->minbits, zfp->maxbits, zfp->maxprec, iblock);
 }
+
+/* decode count contiguous integer blocks stored back to back */
+size_t
+_t2(zfp_decode_blocks, Int, DIMS)(zfp_stream* zfp, Int* iblock, size_t count, size_t* offset)
+{
+  size_t base = offset ? stream_rtell(zfp->stream) : 0;
+  size_t bits = 0;
+  size_t i;
+  /* hoist mode dispatch out of loop over blocks */
+  if (REVERSIBLE(zfp))
+    for (i = 0; i < count; i++, iblock += BLOCK_SIZE) {
+      if (offset)
+        offset[i] = base + bits;
+      bits += _t2(rev_decode_block, Int, DIMS)(zfp->stream, zfp->minbits, zfp->maxbits, iblock);
+    }
+  else
+    for (i = 0; i < count; i++, iblock += BLOCK_SIZE) {
+      if (offset)
+        offset[i] = base + bits;
+      bits += _t2(decode_block, Int, DIMS)(zfp->stream, zfp->minbits, zfp->maxbits, zfp->maxprec, iblock);
+    }
+  return bits;
+}
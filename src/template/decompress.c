@@ -107,3 +107,169 @@ _t2(decompress_strided, Scalar, 4)(zfp_stream* stream, zfp_field* field)
             _t2(zfp_decode_block_strided, Scalar, 4)(stream, p, sx, sy, sz, sw);
         }
 }
+
+/* scatter m[0]*m[1]*m[2]*m[3] values from nc consecutive blocks of bs
+   values each to array of nc interleaved components */
+static void
+_t1(scatter_components, Scalar)(const Scalar* q, Scalar* p, uint nc, uint bs, const size_t* m, const ptrdiff_t* s)
+{
+  size_t x, y, z, w;
+  uint c;
+  for (w = 0; w < m[3]; w++, p += s[3] - (ptrdiff_t)m[2] * s[2])
+    for (z = 0; z < m[2]; z++, p += s[2] - (ptrdiff_t)m[1] * s[1])
+      for (y = 0; y < m[1]; y++, p += s[1] - (ptrdiff_t)m[0] * s[0])
+        for (x = 0; x < m[0]; x++, p += s[0])
+          for (c = 0; c < nc; c++)
+            p[c] = q[c * bs + 64 * w + 16 * z + 4 * y + x];
+}
+
+/* decompress array of interleaved components, decoding consecutive blocks
+   of all components and scattering them in one pass */
+static void
+_t1(decompress_components, Scalar)(zfp_stream* stream, zfp_field* field)
+{
+  Scalar* data = (Scalar*)field->data;
+  uint dims = zfp_field_dimensionality(field);
+  uint nc = zfp_field_components(field);
+  uint bs = 1u << (2 * dims);
+  cache_align_(Scalar block[ZFP_MAX_COMPONENTS * 256]);
+  ptrdiff_t s[4] = { 0, 0, 0, 0 };
+  size_t nx = field->nx;
+  size_t ny = MAX(field->ny, 1u);
+  size_t nz = MAX(field->nz, 1u);
+  size_t nw = MAX(field->nw, 1u);
+  size_t x, y, z, w;
+  uint c;
+
+  zfp_field_stride(field, s);
+  for (w = 0; w < nw; w += 4)
+    for (z = 0; z < nz; z += 4)
+      for (y = 0; y < ny; y += 4)
+        for (x = 0; x < nx; x += 4) {
+          Scalar* p = data + s[0] * (ptrdiff_t)x + s[1] * (ptrdiff_t)y + s[2] * (ptrdiff_t)z + s[3] * (ptrdiff_t)w;
+          size_t m[4];
+          m[0] = MIN(nx - x, 4u);
+          m[1] = MIN(ny - y, 4u);
+          m[2] = MIN(nz - z, 4u);
+          m[3] = MIN(nw - w, 4u);
+          /* partial blocks are decoded in full and clipped upon scatter */
+          for (c = 0; c < nc; c++)
+            switch (dims) {
+              case 1: _t2(zfp_decode_block, Scalar, 1)(stream, block + c * bs); break;
+              case 2: _t2(zfp_decode_block, Scalar, 2)(stream, block + c * bs); break;
+              case 3: _t2(zfp_decode_block, Scalar, 3)(stream, block + c * bs); break;
+              case 4: _t2(zfp_decode_block, Scalar, 4)(stream, block + c * bs); break;
+            }
+          _t1(scatter_components, Scalar)(block, p, nc, bs, m, s);
+        }
+}
+
+/* decompress box of values with given origin and extents from array */
+static zfp_bool
+_t1(decompress_box, Scalar)(zfp_stream* zfp, const zfp_field* field, zfp_field* box, const size_t* origin)
+{
+  bitstream* s = zfp->stream;
+  uint dims = zfp_field_dimensionality(field);
+  zfp_bool fixed = (zfp->minbits == zfp->maxbits);
+  size_t (*decode)(zfp_stream*, Scalar*);
+  Scalar* data = (Scalar*)box->data;
+  Scalar block[256];
+  ptrdiff_t sb[4] = { 0, 0, 0, 0 };
+  size_t n[4], m[4], b0[4], b1[4], nb[4];
+  size_t blocks, chunks = 0, next = 0, chunk;
+  uint64* offset = NULL;
+  size_t start, base;
+  size_t i, b[4];
+
+  switch (dims) {
+    case 1: decode = _t2(zfp_decode_block, Scalar, 1); break;
+    case 2: decode = _t2(zfp_decode_block, Scalar, 2); break;
+    case 3: decode = _t2(zfp_decode_block, Scalar, 3); break;
+    case 4: decode = _t2(zfp_decode_block, Scalar, 4); break;
+    default: return zfp_false;
+  }
+
+  /* array and box dimensions in values and blocks */
+  n[0] = field->nx; nb[0] = box->nx;
+  n[1] = field->ny; nb[1] = box->ny;
+  n[2] = field->nz; nb[2] = box->nz;
+  n[3] = field->nw; nb[3] = box->nw;
+  zfp_field_stride(box, sb);
+  for (i = 0; i < 4; i++) {
+    n[i] = MAX(n[i], 1u);
+    nb[i] = MAX(nb[i], 1u);
+    if (origin[i] + nb[i] > n[i])
+      return zfp_false;
+    m[i] = (n[i] + 3) / 4;
+    b0[i] = origin[i] / 4;
+    b1[i] = (origin[i] + nb[i] + 3) / 4;
+  }
+  blocks = m[0] * m[1] * m[2] * m[3];
+
+  /* read chunk offsets if present */
+  start = stream_rtell(s);
+  if (zfp->chunk_index) {
+    uint64 prev = 0;
+    size_t bits;
+    chunks = chunk_index_read_count(s, blocks);
+    offset = chunks ? (uint64*)malloc(chunks * sizeof(uint64)) : NULL;
+    if (!offset) {
+      stream_rseek(s, start);
+      return zfp_false;
+    }
+    /* chunks must begin within stream and follow one another */
+    bits = stream_capacity(s) * CHAR_BIT - (stream_rtell(s) + 64 * chunks);
+    for (chunk = 0; chunk < chunks; chunk++) {
+      if (!chunk_index_read_offset(s, &offset[chunk], prev, bits)) {
+        free(offset);
+        stream_rseek(s, start);
+        return zfp_false;
+      }
+      prev = offset[chunk];
+    }
+  }
+  base = stream_rtell(s);
+
+  /* visit overlapping blocks in stream order */
+  for (b[3] = b0[3]; b[3] < b1[3]; b[3]++)
+    for (b[2] = b0[2]; b[2] < b1[2]; b[2]++)
+      for (b[1] = b0[1]; b[1] < b1[1]; b[1]++)
+        for (b[0] = b0[0]; b[0] < b1[0]; b[0]++) {
+          size_t index = ((b[3] * m[2] + b[2]) * m[1] + b[1]) * m[0] + b[0];
+          size_t lo[4], hi[4], x, y, z, w;
+          /* position stream at block */
+          if (fixed)
+            stream_rseek(s, base + index * zfp->maxbits);
+          else {
+            if (chunks) {
+              /* seek to beginning of chunk unless already inside it */
+              chunk = (size_t)(((uint64)(index + 1) * chunks - 1) / blocks);
+              if (next < chunk_offset(blocks, chunks, chunk)) {
+                next = chunk_offset(blocks, chunks, chunk);
+                stream_rseek(s, base + (size_t)offset[chunk]);
+              }
+            }
+            /* skip over preceding variable-length blocks */
+            for (; next < index; next++)
+              decode(zfp, block);
+          }
+          decode(zfp, block);
+          next = index + 1;
+          /* copy values inside box */
+          for (i = 0; i < 4; i++) {
+            lo[i] = MAX(4 * b[i], origin[i]);
+            hi[i] = MIN(4 * b[i] + 4, origin[i] + nb[i]);
+          }
+          for (w = lo[3]; w < hi[3]; w++)
+            for (z = lo[2]; z < hi[2]; z++)
+              for (y = lo[1]; y < hi[1]; y++)
+                for (x = lo[0]; x < hi[0]; x++)
+                  data[(ptrdiff_t)(x - origin[0]) * sb[0] + (ptrdiff_t)(y - origin[1]) * sb[1] + (ptrdiff_t)(z - origin[2]) * sb[2] + (ptrdiff_t)(w - origin[3]) * sb[3]] =
+                    block[(x - 4 * b[0]) + 4 * ((y - 4 * b[1]) + 4 * ((z - 4 * b[2]) + 4 * (w - 4 * b[3])))];
+        }
+
+  /* leave stream positioned for further random access */
+  free(offset);
+  stream_rseek(s, start);
+  return zfp_true;
+}
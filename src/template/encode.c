@@ -87,6 +87,41 @@ _t1(fwd_order, Int)(UInt* ublock, const Int* iblock, const uchar* perm, uint n)
   while (--n);
 }
 
+/* extract bit plane #k from sequence of size <= 64 unsigned integers */
+static uint64
+_t1(bit_plane, UInt)(const UInt* restrict_ data, uint size, uint k)
+{
+  uint64 x = 0;
+  uint i;
+  for (i = 0; i < size; i++)
+    x += (uint64)((data[i] >> k) & 1u) << i;
+  return x;
+}
+
+/* transpose 64x64 bit matrix in place such that bit j of a[i] becomes bit i of a[j] */
+static void
+transpose_bits(uint64* a)
+{
+  uint64 m = UINT64C(0x00000000ffffffff);
+  uint j, k;
+  for (j = 32; j; j >>= 1, m ^= m << j)
+    for (k = 0; k < 64; k = (k + j + 1) & ~j) {
+      uint64 t = ((a[k] >> j) ^ a[k + j]) & m;
+      a[k] ^= t << j;
+      a[k + j] ^= t;
+    }
+}
+
+/* extract all bit planes from sequence of 64 unsigned integers at once */
+static void
+_t1(bit_planes, UInt)(uint64* restrict_ plane, const UInt* restrict_ data)
+{
+  uint i;
+  for (i = 0; i < 64; i++)
+    plane[i] = (uint64)data[i];
+  transpose_bits(plane);
+}
+
 /* compress sequence of size <= 64 unsigned integers */
 static uint
 _t1(encode_few_ints, UInt)(bitstream* restrict_ stream, uint maxbits, uint maxprec, const UInt* restrict_ data, uint size)
@@ -98,32 +133,38 @@ _t1(encode_few_ints, UInt)(bitstream* restrict_ stream, uint maxbits, uint maxpr
   uint bits = maxbits;
   uint i, k, m, n;
   uint64 x;
+  uint64 plane[64];
+
+  /* transposing all bit planes at once pays off only for 3D blocks */
+  if (size == 64)
+    _t1(bit_planes, UInt)(plane, data);
 
   /* encode one bit plane at a time from MSB to LSB */
   for (k = intprec, n = 0; bits && k-- > kmin;) {
     /* step 1: extract bit plane #k to x */
-    x = 0;
-    for (i = 0; i < size; i++)
-      x += (uint64)((data[i] >> k) & 1u) << i;
+    x = size == 64 ? plane[k] : _t1(bit_plane, UInt)(data, size, k);
     /* step 2: encode first n bits of bit plane */
     m = MIN(n, bits);
     bits -= m;
     x = stream_write_bits(&s, x, m);
     /* step 3: unary run-length encode remainder of bit plane */
-    for (; bits && n < size; x >>= 1, n++) {
-      bits--;
-      if (stream_write_bit(&s, !!x)) {
-        /* positive group test (x != 0); scan for one-bit */
-        for (; bits && n < size - 1; x >>= 1, n++) {
-          bits--;
-          if (stream_write_bit(&s, x & 1u))
-            break;
-        }
-      }
-      else {
+    while (bits && n < size) {
+      if (!x) {
         /* negative group test (x == 0); done with bit plane */
+        bits--;
+        stream_write_bit(&s, 0);
         break;
       }
+      /* positive group test followed by run of i zeros and the one-bit that
+         ends it, which is implied for the last value */
+      i = trailing_zeros(x);
+      m = n + i < size - 1 ? i + 2 : i + 1;
+      m = MIN(m, bits);
+      bits -= m;
+      stream_write_bits(&s, 1 + ((uint64)2 << i), m);
+      x >>= i;
+      x >>= 1;
+      n += i + 1;
     }
   }
 
@@ -185,19 +226,29 @@ _t1(encode_few_ints_prec, UInt)(bitstream* restrict_ stream, uint maxprec, const
   uint intprec = (uint)(CHAR_BIT * sizeof(UInt));
   uint kmin = intprec > maxprec ? intprec - maxprec : 0;
   uint i, k, n;
+  uint64 x;
+  uint64 plane[64];
+
+  /* transposing all bit planes at once pays off only for 3D blocks */
+  if (size == 64)
+    _t1(bit_planes, UInt)(plane, data);
 
   /* encode one bit plane at a time from MSB to LSB */
   for (k = intprec, n = 0; k-- > kmin;) {
     /* step 1: extract bit plane #k to x */
-    uint64 x = 0;
-    for (i = 0; i < size; i++)
-      x += (uint64)((data[i] >> k) & 1u) << i;
+    x = size == 64 ? plane[k] : _t1(bit_plane, UInt)(data, size, k);
     /* step 2: encode first n bits of bit plane */
     x = stream_write_bits(&s, x, n);
     /* step 3: unary run-length encode remainder of bit plane */
-    for (; n < size && stream_write_bit(&s, !!x); x >>= 1, n++)
-      for (; n < size - 1 && !stream_write_bit(&s, x & 1u); x >>= 1, n++)
-        ;
+    for (; n < size && x; x >>= 1, n += i + 1) {
+      /* positive group test, run of i zeros, and (unless implied) one-bit */
+      i = trailing_zeros(x);
+      stream_write_bits(&s, 1 + ((uint64)2 << i), n + i < size - 1 ? i + 2 : i + 1);
+      x >>= i;
+    }
+    /* negative group test */
+    if (n < size)
+      stream_write_bit(&s, 0);
   }
 
   *stream = s;
@@ -255,14 +306,12 @@ _t1(encode_ints, UInt)(bitstream* restrict_ stream, uint maxbits, uint maxprec,
   }
 }
 
-/* encode block of integers */
+/* encode block of transform coefficients */
 static uint
-_t2(encode_block, Int, DIMS)(bitstream* stream, int minbits, int maxbits, int maxprec, Int* iblock)
+_t2(encode_coefficients, Int, DIMS)(bitstream* stream, int minbits, int maxbits, int maxprec, Int* iblock)
 {
   int bits;
   cache_align_(UInt ublock[BLOCK_SIZE]);
-  /* perform decorrelating transform */
-  _t2(fwd_xform, Int, DIMS)(iblock);
 #if ZFP_ROUNDING_MODE == ZFP_ROUND_FIRST
   /* bias values to achieve proper rounding */
   _t1(fwd_round, Int)(iblock, BLOCK_SIZE, maxprec);
@@ -278,3 +327,13 @@ _t2(encode_block, Int, DIMS)(bitstream* stream, int minbits, int maxbits, int ma
   }
   return bits;
 }
+
+/* encode block of integers */
+static uint
+_t2(encode_block, Int, DIMS)(bitstream* stream, int minbits, int maxbits, int maxprec, Int* iblock)
+{
+  /* perform decorrelating transform */
+  _t2(fwd_xform, Int, DIMS)(iblock);
+  /* encode transform coefficients */
+  return _t2(encode_coefficients, Int, DIMS)(stream, minbits, maxbits, maxprec, iblock);
+}
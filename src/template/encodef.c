@@ -97,3 +97,61 @@ _t2(zfp_encode_block, Scalar, DIMS)(zfp_stream* zfp, const Scalar* fblock)
 {
   return REVERSIBLE(zfp) ? _t2(rev_encode_block, Scalar, DIMS)(zfp, fblock) : _t2(encode_block, Scalar, DIMS)(zfp, fblock);
 }
+
+/* encode block of transform coefficients relative to common exponent */
+size_t
+_t2(zfp_encode_coefficients, Scalar, DIMS)(zfp_stream* zfp, const Int* coeff, int emax)
+{
+  uint bits = 1;
+  int maxprec;
+  uint e;
+  /* coefficients are entropy coded only in lossy modes, and the exponent
+     must be representable */
+  if (REVERSIBLE(zfp) || emax + EBIAS >= (1 << EBITS))
+    return 0;
+  maxprec = emax > -EBIAS ? precision(emax, zfp->maxprec, zfp->minexp, DIMS) : 0;
+  e = maxprec ? (uint)(emax + EBIAS) : 0;
+  if (e) {
+    cache_align_(Int iblock[BLOCK_SIZE]);
+    uint i;
+    /* encode common exponent; LSB indicates that exponent is nonzero */
+    bits += EBITS;
+    stream_write_bits(zfp->stream, 2 * e + 1, bits);
+    /* encode copy of coefficients, which may be biased for rounding */
+    for (i = 0; i < BLOCK_SIZE; i++)
+      iblock[i] = coeff[i];
+    bits += _t2(encode_coefficients, Int, DIMS)(zfp->stream, zfp->minbits - bits, zfp->maxbits - bits, maxprec, iblock);
+  }
+  else {
+    /* write single zero-bit to indicate that all values are zero */
+    stream_write_bit(zfp->stream, 0);
+    if (zfp->minbits > bits) {
+      stream_pad(zfp->stream, zfp->minbits - bits);
+      bits = zfp->minbits;
+    }
+  }
+  return bits;
+}
+
+/* encode count contiguous floating-point blocks stored back to back */
+size_t
+_t2(zfp_encode_blocks, Scalar, DIMS)(zfp_stream* zfp, const Scalar* fblock, size_t count, size_t* offset)
+{
+  size_t base = offset ? stream_wtell(zfp->stream) : 0;
+  size_t bits = 0;
+  size_t i;
+  /* hoist mode dispatch out of loop over blocks */
+  if (REVERSIBLE(zfp))
+    for (i = 0; i < count; i++, fblock += BLOCK_SIZE) {
+      if (offset)
+        offset[i] = base + bits;
+      bits += _t2(rev_encode_block, Scalar, DIMS)(zfp, fblock);
+    }
+  else
+    for (i = 0; i < count; i++, fblock += BLOCK_SIZE) {
+      if (offset)
+        offset[i] = base + bits;
+      bits += _t2(encode_block, Scalar, DIMS)(zfp, fblock);
+    }
+  return bits;
+}
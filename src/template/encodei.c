@@ -13,3 +13,34 @@ _t2(zfp_encode_block, Int, DIMS)(zfp_stream* zfp, const Int* iblock)
     block[i] = iblock[i];
   return REVERSIBLE(zfp) ? _t2(rev_encode_block, Int, DIMS)(zfp->stream, zfp->minbits, zfp->maxbits, zfp->maxprec, block) : _t2(encode_block, Int, DIMS)(zfp->stream, zfp->minbits, zfp->maxbits, zfp->maxprec, block);
 }
+
+/* encode count contiguous integer blocks stored back to back */
+size_t
+_t2(zfp_encode_blocks, Int, DIMS)(zfp_stream* zfp, const Int* iblock, size_t count, size_t* offset)
+{
+  cache_align_(Int block[BLOCK_SIZE]);
+  size_t base = offset ? stream_wtell(zfp->stream) : 0;
+  size_t bits = 0;
+  size_t i;
+  uint j;
+  /* hoist mode dispatch out of loop over blocks */
+  if (REVERSIBLE(zfp))
+    for (i = 0; i < count; i++, iblock += BLOCK_SIZE) {
+      if (offset)
+        offset[i] = base + bits;
+      /* copy block */
+      for (j = 0; j < BLOCK_SIZE; j++)
+        block[j] = iblock[j];
+      bits += _t2(rev_encode_block, Int, DIMS)(zfp->stream, zfp->minbits, zfp->maxbits, zfp->maxprec, block);
+    }
+  else
+    for (i = 0; i < count; i++, iblock += BLOCK_SIZE) {
+      if (offset)
+        offset[i] = base + bits;
+      /* copy block */
+      for (j = 0; j < BLOCK_SIZE; j++)
+        block[j] = iblock[j];
+      bits += _t2(encode_block, Int, DIMS)(zfp->stream, zfp->minbits, zfp->maxbits, zfp->maxprec, block);
+    }
+  return bits;
+}
@@ -0,0 +1,139 @@
+/* compressed-domain linear operations on floating-point blocks */
+
+/* decode transform coefficients of block and return their common exponent */
+static int
+_t1(decode_coefficients, Scalar)(zfp_stream* zfp, Int* coeff, uint dims)
+{
+  int emax;
+  switch (dims) {
+    case 1:
+      _t2(zfp_decode_coefficients, Scalar, 1)(zfp, coeff, &emax);
+      break;
+    case 2:
+      _t2(zfp_decode_coefficients, Scalar, 2)(zfp, coeff, &emax);
+      break;
+    case 3:
+      _t2(zfp_decode_coefficients, Scalar, 3)(zfp, coeff, &emax);
+      break;
+    default:
+      _t2(zfp_decode_coefficients, Scalar, 4)(zfp, coeff, &emax);
+      break;
+  }
+  return emax;
+}
+
+/* encode transform coefficients of block; return false if emax is too large */
+static zfp_bool
+_t1(encode_coefficients, Scalar)(zfp_stream* zfp, const Int* coeff, int emax, uint dims)
+{
+  switch (dims) {
+    case 1:
+      return _t2(zfp_encode_coefficients, Scalar, 1)(zfp, coeff, emax) != 0;
+    case 2:
+      return _t2(zfp_encode_coefficients, Scalar, 2)(zfp, coeff, emax) != 0;
+    case 3:
+      return _t2(zfp_encode_coefficients, Scalar, 3)(zfp, coeff, emax) != 0;
+    default:
+      return _t2(zfp_encode_coefficients, Scalar, 4)(zfp, coeff, emax) != 0;
+  }
+}
+
+/* divide n coefficients by 2^s, rounding to nearest */
+static void
+_t1(shift_coefficients, Scalar)(Int* coeff, uint n, int s)
+{
+  uint i;
+  if (s <= 0)
+    return;
+  if (s >= (int)(CHAR_BIT * sizeof(Int)))
+    for (i = 0; i < n; i++)
+      coeff[i] = 0;
+  else {
+    Int r = (Int)1 << (s - 1);
+    for (i = 0; i < n; i++)
+      coeff[i] = (coeff[i] + r) >> s;
+  }
+}
+
+/* clamp exponent from below as the encoder does for subnormals */
+static int
+_t1(normalize_coefficients, Scalar)(Int* coeff, uint n, int emax)
+{
+  if (emax < 1 - EBIAS) {
+    _t1(shift_coefficients, Scalar)(coeff, n, 1 - EBIAS - emax);
+    emax = 1 - EBIAS;
+  }
+  return emax;
+}
+
+/* scale values of compressed blocks by a */
+static zfp_bool
+_t1(scale_stream, Scalar)(zfp_stream* dst, zfp_stream* src, uint dims, size_t blocks, double a)
+{
+  Int coeff[256];
+  uint n = 1u << (2 * dims);
+  int k;
+  double m = frexp(a, &k);
+  /* scaling by a power of two changes only the common exponent */
+  zfp_bool exact = (fabs(m) == 0.5);
+  size_t block;
+  uint i;
+
+  if (exact)
+    k--;
+
+  for (block = 0; block < blocks; block++) {
+    int emax = _t1(decode_coefficients, Scalar)(src, coeff, dims);
+    /* leave blocks of all zeros untouched */
+    if (emax > -EBIAS) {
+      if (a == 0)
+        emax = -EBIAS;
+      else {
+        /* multiply by mantissa 1/2 <= |m| < 1, which cannot overflow */
+        if (exact) {
+          if (m < 0)
+            for (i = 0; i < n; i++)
+              coeff[i] = -coeff[i];
+        }
+        else
+          for (i = 0; i < n; i++)
+            coeff[i] = (Int)floor(m * (double)coeff[i] + 0.5);
+        emax = _t1(normalize_coefficients, Scalar)(coeff, n, emax + k);
+      }
+    }
+    if (!_t1(encode_coefficients, Scalar)(dst, coeff, emax, dims))
+      return zfp_false;
+  }
+
+  return zfp_true;
+}
+
+/* add values of compressed blocks stored in two streams */
+static zfp_bool
+_t1(add_streams, Scalar)(zfp_stream* dst, zfp_stream* src1, zfp_stream* src2, uint dims, size_t blocks)
+{
+  Int coeff1[256];
+  Int coeff2[256];
+  uint n = 1u << (2 * dims);
+  size_t block;
+  uint i;
+
+  for (block = 0; block < blocks; block++) {
+    int emax1 = _t1(decode_coefficients, Scalar)(src1, coeff1, dims);
+    int emax2 = _t1(decode_coefficients, Scalar)(src2, coeff2, dims);
+    int emax = -EBIAS;
+    if (emax1 > -EBIAS || emax2 > -EBIAS) {
+      /* align coefficients to common exponent with one bit of headroom for
+         carries, then add them */
+      emax = MAX(emax1, emax2) + 1;
+      _t1(shift_coefficients, Scalar)(coeff1, n, emax - emax1);
+      _t1(shift_coefficients, Scalar)(coeff2, n, emax - emax2);
+      for (i = 0; i < n; i++)
+        coeff1[i] += coeff2[i];
+    }
+    if (!_t1(encode_coefficients, Scalar)(dst, coeff1, emax, dims))
+      return zfp_false;
+  }
+
+  return zfp_true;
+}
@@ -0,0 +1,238 @@
+/* values of type Scalar are (de)compressed as type Codec, with conversion
+   performed one block at a time during gather and scatter; the conversions
+   _t1(fwd_convert, Scalar) and _t1(inv_convert, Scalar) are defined in
+   narrowf.c, narrowi.c, or cast.c */
+
+/* private functions ------------------------------------------------------- */
+
+/* gather nx*ny*nz*nw block from strided array into 4*4*4*4 block of Codec values */
+static void
+_t1(gather_convert, Scalar)(Codec* q, const Scalar* p, size_t nx, size_t ny, size_t nz, size_t nw, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz, ptrdiff_t sw)
+{
+  size_t x, y, z, w;
+  for (w = 0; w < nw; w++, p += sw - (ptrdiff_t)nz * sz)
+    for (z = 0; z < nz; z++, p += sz - (ptrdiff_t)ny * sy)
+      for (y = 0; y < ny; y++, p += sy - (ptrdiff_t)nx * sx)
+        for (x = 0; x < nx; x++, p += sx)
+          q[64 * w + 16 * z + 4 * y + x] = _t1(fwd_convert, Scalar)(*p);
+}
+
+/* scatter nx*ny*nz*nw values of 4*4*4*4 block of Codec values to strided array */
+static void
+_t1(scatter_convert, Scalar)(const Codec* q, Scalar* p, size_t nx, size_t ny, size_t nz, size_t nw, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz, ptrdiff_t sw)
+{
+  size_t x, y, z, w;
+  for (w = 0; w < nw; w++, p += sw - (ptrdiff_t)nz * sz)
+    for (z = 0; z < nz; z++, p += sz - (ptrdiff_t)ny * sy)
+      for (y = 0; y < ny; y++, p += sy - (ptrdiff_t)nx * sx)
+        for (x = 0; x < nx; x++, p += sx)
+          *p = _t1(inv_convert, Scalar)(q[64 * w + 16 * z + 4 * y + x]);
+}
+
+/* encode 4-value block stored at p using stride sx */
+static size_t
+_t2(zfp_encode_block_strided, Scalar, 1)(zfp_stream* stream, const Scalar* p, ptrdiff_t sx)
+{
+  cache_align_(Codec block[4]);
+  _t1(gather_convert, Scalar)(block, p, 4, 1, 1, 1, sx, 0, 0, 0);
+  return _t2(zfp_encode_block, Codec, 1)(stream, block);
+}
+
+/* encode contiguous 4-value block */
+static size_t
+_t2(zfp_encode_block, Scalar, 1)(zfp_stream* stream, const Scalar* block)
+{
+  return _t2(zfp_encode_block_strided, Scalar, 1)(stream, block, 1);
+}
+
+/* encode 4*4 block stored at p using strides (sx, sy) */
+static size_t
+_t2(zfp_encode_block_strided, Scalar, 2)(zfp_stream* stream, const Scalar* p, ptrdiff_t sx, ptrdiff_t sy)
+{
+  cache_align_(Codec block[16]);
+  _t1(gather_convert, Scalar)(block, p, 4, 4, 1, 1, sx, sy, 0, 0);
+  return _t2(zfp_encode_block, Codec, 2)(stream, block);
+}
+
+/* encode 4*4*4 block stored at p using strides (sx, sy, sz) */
+static size_t
+_t2(zfp_encode_block_strided, Scalar, 3)(zfp_stream* stream, const Scalar* p, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz)
+{
+  cache_align_(Codec block[64]);
+  _t1(gather_convert, Scalar)(block, p, 4, 4, 4, 1, sx, sy, sz, 0);
+  return _t2(zfp_encode_block, Codec, 3)(stream, block);
+}
+
+/* encode 4*4*4*4 block stored at p using strides (sx, sy, sz, sw) */
+static size_t
+_t2(zfp_encode_block_strided, Scalar, 4)(zfp_stream* stream, const Scalar* p, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz, ptrdiff_t sw)
+{
+  cache_align_(Codec block[256]);
+  _t1(gather_convert, Scalar)(block, p, 4, 4, 4, 4, sx, sy, sz, sw);
+  return _t2(zfp_encode_block, Codec, 4)(stream, block);
+}
+
+/* encode contiguous 4*4 block */
+static size_t
+_t2(zfp_encode_block, Scalar, 2)(zfp_stream* stream, const Scalar* block)
+{
+  return _t2(zfp_encode_block_strided, Scalar, 2)(stream, block, 1, 4);
+}
+
+/* encode contiguous 4*4*4 block */
+static size_t
+_t2(zfp_encode_block, Scalar, 3)(zfp_stream* stream, const Scalar* block)
+{
+  return _t2(zfp_encode_block_strided, Scalar, 3)(stream, block, 1, 4, 16);
+}
+
+/* encode contiguous 4*4*4*4 block */
+static size_t
+_t2(zfp_encode_block, Scalar, 4)(zfp_stream* stream, const Scalar* block)
+{
+  return _t2(zfp_encode_block_strided, Scalar, 4)(stream, block, 1, 4, 16, 64);
+}
+
+/* encode nx-value block stored at p using stride sx */
+static size_t
+_t2(zfp_encode_partial_block_strided, Scalar, 1)(zfp_stream* stream, const Scalar* p, size_t nx, ptrdiff_t sx)
+{
+  cache_align_(Codec block[4]);
+  _t1(gather_convert, Scalar)(block, p, nx, 1, 1, 1, sx, 0, 0, 0);
+  return _t2(zfp_encode_partial_block_strided, Codec, 1)(stream, block, nx, 1);
+}
+
+/* encode nx*ny block stored at p using strides (sx, sy) */
+static size_t
+_t2(zfp_encode_partial_block_strided, Scalar, 2)(zfp_stream* stream, const Scalar* p, size_t nx, size_t ny, ptrdiff_t sx, ptrdiff_t sy)
+{
+  cache_align_(Codec block[16]);
+  _t1(gather_convert, Scalar)(block, p, nx, ny, 1, 1, sx, sy, 0, 0);
+  return _t2(zfp_encode_partial_block_strided, Codec, 2)(stream, block, nx, ny, 1, 4);
+}
+
+/* encode nx*ny*nz block stored at p using strides (sx, sy, sz) */
+static size_t
+_t2(zfp_encode_partial_block_strided, Scalar, 3)(zfp_stream* stream, const Scalar* p, size_t nx, size_t ny, size_t nz, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz)
+{
+  cache_align_(Codec block[64]);
+  _t1(gather_convert, Scalar)(block, p, nx, ny, nz, 1, sx, sy, sz, 0);
+  return _t2(zfp_encode_partial_block_strided, Codec, 3)(stream, block, nx, ny, nz, 1, 4, 16);
+}
+
+/* encode nx*ny*nz*nw block stored at p using strides (sx, sy, sz, sw) */
+static size_t
+_t2(zfp_encode_partial_block_strided, Scalar, 4)(zfp_stream* stream, const Scalar* p, size_t nx, size_t ny, size_t nz, size_t nw, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz, ptrdiff_t sw)
+{
+  cache_align_(Codec block[256]);
+  _t1(gather_convert, Scalar)(block, p, nx, ny, nz, nw, sx, sy, sz, sw);
+  return _t2(zfp_encode_partial_block_strided, Codec, 4)(stream, block, nx, ny, nz, nw, 1, 4, 16, 64);
+}
+
+/* decode 4-value block and store at p using stride sx */
+static size_t
+_t2(zfp_decode_block_strided, Scalar, 1)(zfp_stream* stream, Scalar* p, ptrdiff_t sx)
+{
+  cache_align_(Codec block[4]);
+  size_t bits = _t2(zfp_decode_block, Codec, 1)(stream, block);
+  _t1(scatter_convert, Scalar)(block, p, 4, 1, 1, 1, sx, 0, 0, 0);
+  return bits;
+}
+
+/* decode 4*4 block and store at p using strides (sx, sy) */
+static size_t
+_t2(zfp_decode_block_strided, Scalar, 2)(zfp_stream* stream, Scalar* p, ptrdiff_t sx, ptrdiff_t sy)
+{
+  cache_align_(Codec block[16]);
+  size_t bits = _t2(zfp_decode_block, Codec, 2)(stream, block);
+  _t1(scatter_convert, Scalar)(block, p, 4, 4, 1, 1, sx, sy, 0, 0);
+  return bits;
+}
+
+/* decode 4*4*4 block and store at p using strides (sx, sy, sz) */
+static size_t
+_t2(zfp_decode_block_strided, Scalar, 3)(zfp_stream* stream, Scalar* p, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz)
+{
+  cache_align_(Codec block[64]);
+  size_t bits = _t2(zfp_decode_block, Codec, 3)(stream, block);
+  _t1(scatter_convert, Scalar)(block, p, 4, 4, 4, 1, sx, sy, sz, 0);
+  return bits;
+}
+
+/* decode 4*4*4*4 block and store at p using strides (sx, sy, sz, sw) */
+static size_t
+_t2(zfp_decode_block_strided, Scalar, 4)(zfp_stream* stream, Scalar* p, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz, ptrdiff_t sw)
+{
+  cache_align_(Codec block[256]);
+  size_t bits = _t2(zfp_decode_block, Codec, 4)(stream, block);
+  _t1(scatter_convert, Scalar)(block, p, 4, 4, 4, 4, sx, sy, sz, sw);
+  return bits;
+}
+
+/* decode contiguous 4-value block */
+static size_t
+_t2(zfp_decode_block, Scalar, 1)(zfp_stream* stream, Scalar* block)
+{
+  return _t2(zfp_decode_block_strided, Scalar, 1)(stream, block, 1);
+}
+
+/* decode contiguous 4*4 block */
+static size_t
+_t2(zfp_decode_block, Scalar, 2)(zfp_stream* stream, Scalar* block)
+{
+  return _t2(zfp_decode_block_strided, Scalar, 2)(stream, block, 1, 4);
+}
+
+/* decode contiguous 4*4*4 block */
+static size_t
+_t2(zfp_decode_block, Scalar, 3)(zfp_stream* stream, Scalar* block)
+{
+  return _t2(zfp_decode_block_strided, Scalar, 3)(stream, block, 1, 4, 16);
+}
+
+/* decode contiguous 4*4*4*4 block */
+static size_t
+_t2(zfp_decode_block, Scalar, 4)(zfp_stream* stream, Scalar* block)
+{
+  return _t2(zfp_decode_block_strided, Scalar, 4)(stream, block, 1, 4, 16, 64);
+}
+
+/* decode nx-value block and store at p using stride sx */
+static size_t
+_t2(zfp_decode_partial_block_strided, Scalar, 1)(zfp_stream* stream, Scalar* p, size_t nx, ptrdiff_t sx)
+{
+  cache_align_(Codec block[4]);
+  size_t bits = _t2(zfp_decode_block, Codec, 1)(stream, block);
+  _t1(scatter_convert, Scalar)(block, p, nx, 1, 1, 1, sx, 0, 0, 0);
+  return bits;
+}
+
+/* decode nx*ny block and store at p using strides (sx, sy) */
+static size_t
+_t2(zfp_decode_partial_block_strided, Scalar, 2)(zfp_stream* stream, Scalar* p, size_t nx, size_t ny, ptrdiff_t sx, ptrdiff_t sy)
+{
+  cache_align_(Codec block[16]);
+  size_t bits = _t2(zfp_decode_block, Codec, 2)(stream, block);
+  _t1(scatter_convert, Scalar)(block, p, nx, ny, 1, 1, sx, sy, 0, 0);
+  return bits;
+}
+
+/* decode nx*ny*nz block and store at p using strides (sx, sy, sz) */
+static size_t
+_t2(zfp_decode_partial_block_strided, Scalar, 3)(zfp_stream* stream, Scalar* p, size_t nx, size_t ny, size_t nz, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz)
+{
+  cache_align_(Codec block[64]);
+  size_t bits = _t2(zfp_decode_block, Codec, 3)(stream, block);
+  _t1(scatter_convert, Scalar)(block, p, nx, ny, nz, 1, sx, sy, sz, 0);
+  return bits;
+}
+
+/* decode nx*ny*nz*nw block and store at p using strides (sx, sy, sz, sw) */
+static size_t
+_t2(zfp_decode_partial_block_strided, Scalar, 4)(zfp_stream* stream, Scalar* p, size_t nx, size_t ny, size_t nz, size_t nw, ptrdiff_t sx, ptrdiff_t sy, ptrdiff_t sz, ptrdiff_t sw)
+{
+  cache_align_(Codec block[256]);
+  size_t bits = _t2(zfp_decode_block, Codec, 4)(stream, block);
+  _t1(scatter_convert, Scalar)(block, p, nx, ny, nz, nw, sx, sy, sz, sw);
+  return bits;
+}
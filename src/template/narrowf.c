@@ -0,0 +1,57 @@
+/* conversions between narrow floating-point values and single precision */
+
+/* private functions ------------------------------------------------------- */
+
+/* convert narrow floating-point value to single precision */
+static float
+_t1(fwd_convert, Scalar)(Scalar x)
+{
+  uint32 s = (uint32)(x >> (EBITS + MBITS)) << 31;
+  uint32 e = (x >> MBITS) & ((1u << EBITS) - 1);
+  uint32 m = x & ((1u << MBITS) - 1);
+  uint32 u;
+  float f;
+
+  if (!e) {
+    /* zero or subnormal */
+    f = (float)ldexp((double)m, 1 - EBIAS - MBITS);
+    return s ? -f : f;
+  }
+  if (e == (1u << EBITS) - 1)
+    /* infinity or NaN */
+    u = s | 0x7f800000u | (m << (23 - MBITS));
+  else
+    /* normal */
+    u = s | ((e + 127 - EBIAS) << 23) | (m << (23 - MBITS));
+  memcpy(&f, &u, sizeof(f));
+  return f;
+}
+
+/* convert single-precision value to narrow format, rounding to nearest even */
+static Scalar
+_t1(inv_convert, Scalar)(float f)
+{
+  const uint32 inf = ((1u << EBITS) - 1) << MBITS;
+  uint32 u, s, a;
+
+  memcpy(&u, &f, sizeof(u));
+  s = (u >> 16) & 0x8000u;
+  a = u & 0x7fffffffu;
+
+  if (a > 0x7f800000u)
+    /* quiet NaN */
+    return (Scalar)(s | inf | (1u << (MBITS - 1)) | ((a >> (23 - MBITS)) & ((1u << MBITS) - 1)));
+  if (a < (uint32)(128 - EBIAS) << 23) {
+    /* zero or subnormal; scaling by a power of two is exact */
+    float g = (float)ldexp(fabs(f), EBIAS - 1 + MBITS);
+    uint32 m = (uint32)g;
+    g -= (float)m;
+    if (g > 0.5f || (g == 0.5f && (m & 1u)))
+      m++;
+    return (Scalar)(s | m);
+  }
+  /* normal; rounding may carry into exponent, and overflow yields infinity */
+  a += (1u << (22 - MBITS)) - 1 + ((a >> (23 - MBITS)) & 1u);
+  a = (a >> (23 - MBITS)) - ((uint32)(127 - EBIAS) << MBITS);
+  return (Scalar)(s | MIN(a, inf));
+}
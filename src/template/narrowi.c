@@ -0,0 +1,20 @@
+/* conversions between narrow integers and 32-bit integers; values are
+   mapped to the signed range and scaled to occupy the high bits, as in
+   zfp_promote_*() and zfp_demote_*() */
+
+/* private functions ------------------------------------------------------- */
+
+/* promote narrow integer to 32 bits */
+static int32
+_t1(fwd_convert, Scalar)(Scalar x)
+{
+  return ((int32)x - IBIAS) << (31 - IBITS);
+}
+
+/* demote 32-bit integer to narrow integer with saturation */
+static Scalar
+_t1(inv_convert, Scalar)(int32 x)
+{
+  int32 i = (x >> (31 - IBITS)) + IBIAS;
+  return (Scalar)MAX(IBIAS - (1 << (IBITS - 1)), MIN(i, IBIAS + (1 << (IBITS - 1)) - 1));
+}
@@ -43,8 +43,8 @@ _t2(compress_omp, Scalar, 1)(zfp_stream* stream, const zfp_field* field)
     }
   }
 
-  /* concatenate per-thread streams */
-  compress_finish_par(stream, bs, chunks);
+  /* merge per-thread streams into output stream */
+  compress_finish_omp(stream, bs, chunks, threads);
 }
 
 /* compress 1d strided array in parallel */
@@ -91,8 +91,8 @@ _t2(compress_strided_omp, Scalar, 1)(zfp_stream* stream, const zfp_field* field)
     }
   }
 
-  /* concatenate per-thread streams */
-  compress_finish_par(stream, bs, chunks);
+  /* merge per-thread streams into output stream */
+  compress_finish_omp(stream, bs, chunks, threads);
 }
 
 /* compress 2d strided array in parallel */
@@ -146,8 +146,8 @@ _t2(compress_strided_omp, Scalar, 2)(zfp_stream* stream, const zfp_field* field)
     }
   }
 
-  /* concatenate per-thread streams */
-  compress_finish_par(stream, bs, chunks);
+  /* merge per-thread streams into output stream */
+  compress_finish_omp(stream, bs, chunks, threads);
 }
 
 /* compress 3d strided array in parallel */
@@ -205,8 +205,8 @@ _t2(compress_strided_omp, Scalar, 3)(zfp_stream* stream, const zfp_field* field)
     }
   }
 
-  /* concatenate per-thread streams */
-  compress_finish_par(stream, bs, chunks);
+  /* merge per-thread streams into output stream */
+  compress_finish_omp(stream, bs, chunks, threads);
 }
 
 /* compress 4d strided array in parallel */
@@ -268,8 +268,8 @@ _t2(compress_strided_omp, Scalar, 4)(zfp_stream* stream, const zfp_field* field)
     }
   }
 
-  /* concatenate per-thread streams */
-  compress_finish_par(stream, bs, chunks);
+  /* merge per-thread streams into output stream */
+  compress_finish_omp(stream, bs, chunks, threads);
 }
 
 #endif
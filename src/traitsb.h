@@ -0,0 +1,7 @@
+/* bfloat16 floating-point traits */
+
+#define Scalar bfloat16    /* bfloat16 value stored as 16-bit integer */
+#define Codec float        /* type values are (de)compressed as */
+#define EBITS 8            /* number of exponent bits */
+#define MBITS 7            /* number of mantissa bits */
+#define EBIAS 127          /* exponent bias */
@@ -0,0 +1,7 @@
+/* half-precision floating-point traits */
+
+#define Scalar half        /* IEEE binary16 value stored as 16-bit integer */
+#define Codec float        /* type values are (de)compressed as */
+#define EBITS 5            /* number of exponent bits */
+#define MBITS 10           /* number of mantissa bits */
+#define EBIAS 15           /* exponent bias */
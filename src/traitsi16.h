@@ -0,0 +1,6 @@
+/* 16-bit signed integer traits */
+
+#define Scalar int16       /* integer type */
+#define Codec int32        /* type values are (de)compressed as */
+#define IBITS 16           /* number of value bits */
+#define IBIAS 0            /* offset that maps values to signed range */
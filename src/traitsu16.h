@@ -0,0 +1,6 @@
+/* 16-bit unsigned integer traits */
+
+#define Scalar uint16      /* integer type */
+#define Codec int32        /* type values are (de)compressed as */
+#define IBITS 16           /* number of value bits */
+#define IBIAS 0x8000       /* offset that maps values to signed range */
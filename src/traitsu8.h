@@ -0,0 +1,6 @@
+/* 8-bit unsigned integer traits */
+
+#define Scalar uint8       /* integer type */
+#define Codec int32        /* type values are (de)compressed as */
+#define IBITS 8            /* number of value bits */
+#define IBIAS 0x80         /* offset that maps values to signed range */
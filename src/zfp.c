@@ -2,6 +2,7 @@
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "zfp.h"
 #include "zfp/macros.h"
 #include "zfp/version.h"
@@ -13,16 +14,27 @@ const uint zfp_codec_version = ZFP_CODEC;
 const uint zfp_library_version = ZFP_VERSION;
 const char* const zfp_version_string = "zfp version " ZFP_VERSION_STRING " (May 5, 2019)";
 
+/* private types ----------------------------------------------------------- */
+
+/* cursor over field (de)compressed one slab at a time */
+struct zfp_slab_cursor {
+  zfp_stream* stream; /* compressed stream */
+  zfp_field field;    /* copy of field metadata (data pointer unused) */
+  size_t plane;       /* index of next plane of field to process */
+  zfp_bool compress;  /* true for compression, false for decompression */
+};
+
 /* private functions ------------------------------------------------------- */
 
 static size_t
 field_index_span(const zfp_field* field, ptrdiff_t* min, ptrdiff_t* max)
 {
   /* compute strides */
-  ptrdiff_t sx = field->sx ? field->sx : 1;
-  ptrdiff_t sy = field->sy ? field->sy : (ptrdiff_t)field->nx;
-  ptrdiff_t sz = field->sz ? field->sz : (ptrdiff_t)(field->nx * field->ny);
-  ptrdiff_t sw = field->sw ? field->sw : (ptrdiff_t)(field->nx * field->ny * field->nz);
+  ptrdiff_t nc = (ptrdiff_t)zfp_field_components(field);
+  ptrdiff_t sx = field->sx ? field->sx : nc;
+  ptrdiff_t sy = field->sy ? field->sy : nc * (ptrdiff_t)field->nx;
+  ptrdiff_t sz = field->sz ? field->sz : nc * (ptrdiff_t)(field->nx * field->ny);
+  ptrdiff_t sw = field->sw ? field->sw : nc * (ptrdiff_t)(field->nx * field->ny * field->nz);
   /* compute largest offsets from base pointer */
   ptrdiff_t dx = field->nx ? sx * (ptrdiff_t)(field->nx - 1) : 0;
   ptrdiff_t dy = field->ny ? sy * (ptrdiff_t)(field->ny - 1) : 0;
@@ -30,7 +42,7 @@ field_index_span(const zfp_field* field, ptrdiff_t* min, ptrdiff_t* max)
   ptrdiff_t dw = field->nw ? sw * (ptrdiff_t)(field->nw - 1) : 0;
   /* compute lowest and highest offset */
   ptrdiff_t imin = MIN(dx, 0) + MIN(dy, 0) + MIN(dz, 0) + MIN(dw, 0);
-  ptrdiff_t imax = MAX(dx, 0) + MAX(dy, 0) + MAX(dz, 0) + MAX(dw, 0);
+  ptrdiff_t imax = MAX(dx, 0) + MAX(dy, 0) + MAX(dz, 0) + MAX(dw, 0) + nc - 1;
   if (min)
     *min = imin;
   if (max)
@@ -38,16 +50,237 @@ field_index_span(const zfp_field* field, ptrdiff_t* min, ptrdiff_t* max)
   return imax - imin + 1;
 }
 
+/* scalar type that values of given type are (de)compressed as by default */
+static zfp_type
+default_compressed_type(zfp_type type)
+{
+  switch (type) {
+    case zfp_type_half:
+    case zfp_type_bfloat16:
+      return zfp_type_float;
+    case zfp_type_uint8:
+    case zfp_type_uint16:
+    case zfp_type_int16:
+      return zfp_type_int32;
+    default:
+      return type;
+  }
+}
+
+/* column of (de)compression function tables for values of given type that
+   are (de)compressed as type ctype, or -1 if no such conversion exists */
+static int
+type_index(zfp_type type, zfp_type ctype)
+{
+  if (ctype == default_compressed_type(type))
+    switch (type) {
+      case zfp_type_int32:
+      case zfp_type_int64:
+      case zfp_type_float:
+      case zfp_type_double:
+      case zfp_type_half:
+      case zfp_type_bfloat16:
+      case zfp_type_uint8:
+      case zfp_type_uint16:
+      case zfp_type_int16:
+        return type - zfp_type_int32;
+      default:
+        return -1;
+    }
+  /* conversions between single and double precision */
+  if (type == zfp_type_float && ctype == zfp_type_double)
+    return 9;
+  if (type == zfp_type_double && ctype == zfp_type_float)
+    return 10;
+  return -1;
+}
+
 static zfp_bool
 is_reversible(const zfp_stream* zfp)
 {
   return zfp->minexp < ZFP_MIN_EXP;
 }
 
+/* pointer to size of field's slowest varying dimension, along which slabs
+   of planes are (de)compressed incrementally */
+static size_t*
+field_plane_count(zfp_field* field)
+{
+  switch (zfp_field_dimensionality(field)) {
+    case 1:
+      return &field->nx;
+    case 2:
+      return &field->ny;
+    case 3:
+      return &field->nz;
+    default:
+      return &field->nw;
+  }
+}
+
+/* number of blocks in field, counting each interleaved component separately */
+static size_t
+field_block_count(const zfp_field* field)
+{
+  size_t bx = (MAX(field->nx, 1u) + 3) / 4;
+  size_t by = (MAX(field->ny, 1u) + 3) / 4;
+  size_t bz = (MAX(field->nz, 1u) + 3) / 4;
+  size_t bw = (MAX(field->nw, 1u) + 3) / 4;
+  return bx * by * bz * bw * zfp_field_components(field);
+}
+
+/* allocate cursor for slab-wise (de)compression of field; NULL upon failure */
+static zfp_slab_cursor*
+slab_cursor_open(zfp_stream* zfp, const zfp_field* field, zfp_bool compress)
+{
+  zfp_slab_cursor* cursor;
+
+  /* slabs are (de)compressed serially */
+  if (zfp->exec.policy != zfp_exec_serial)
+    return NULL;
+
+  if (type_index(field->type, zfp_field_compressed_type(field)) < 0)
+    return NULL;
+
+  if (!zfp_field_dimensionality(field))
+    return NULL;
+
+  cursor = (zfp_slab_cursor*)malloc(sizeof(zfp_slab_cursor));
+  if (cursor) {
+    cursor->stream = zfp;
+    cursor->field = *field;
+    cursor->field.data = NULL;
+    cursor->plane = 0;
+    cursor->compress = compress;
+  }
+  return cursor;
+}
+
+/* word align stream and begin chunk index with 64-bit chunk count */
+static void
+chunk_index_begin(bitstream* s, size_t chunks)
+{
+  stream_flush(s);
+  stream_write_bits(s, chunks, 64);
+}
+
+/* append 64-bit bit offset of chunk relative to end of chunk index */
+static void
+chunk_index_append(bitstream* s, uint64 offset)
+{
+  stream_write_bits(s, offset, 64);
+}
+
+/* read number of chunks in index of stream holding given number of blocks;
+   return zero if the index is truncated or corrupt */
+static size_t
+chunk_index_read_count(bitstream* s, size_t blocks)
+{
+  /* the size of a callback stream is not known up front */
+  size_t bits = stream_is_callback(s) ? ~(size_t)0 : stream_capacity(s) * CHAR_BIT;
+  uint64 chunks;
+  stream_align(s);
+  if (bits < 64 || stream_rtell(s) > bits - 64)
+    return 0;
+  chunks = stream_read_bits(s, 64);
+  /* there is at least one block per chunk, and all offsets must fit */
+  if (!chunks || chunks > blocks || chunks > INT_MAX || (bits - stream_rtell(s)) / 64 < chunks)
+    return 0;
+  return (size_t)chunks;
+}
+
+/* read offset of next chunk, which must not precede the offset prev of the
+   previous chunk nor exceed the number of bits following the index */
+static zfp_bool
+chunk_index_read_offset(bitstream* s, uint64* offset, uint64 prev, size_t bits)
+{
+  *offset = stream_read_bits(s, 64);
+  return *offset >= prev && *offset <= bits;
+}
+
+/* skip chunk index of stream holding given number of blocks and return
+   number of chunks, or zero if the index is truncated or corrupt */
+static size_t
+chunk_index_skip(bitstream* s, size_t blocks)
+{
+  size_t chunks = chunk_index_read_count(s, blocks);
+  if (chunks)
+    stream_rseek(s, stream_rtell(s) + 64 * chunks);
+  return chunks;
+}
+
+/* largest magnitude among values of floating-point block decoded from stream */
+static double
+block_magnitude(zfp_stream* zfp, zfp_type type, uint dims)
+{
+  union {
+    float f[256];
+    double d[256];
+  } block;
+  uint n = 1u << (2 * dims);
+  double max = 0;
+  uint i;
+
+  if (type == zfp_type_float) {
+    switch (dims) {
+      case 1:
+        zfp_decode_block_float_1(zfp, block.f);
+        break;
+      case 2:
+        zfp_decode_block_float_2(zfp, block.f);
+        break;
+      case 3:
+        zfp_decode_block_float_3(zfp, block.f);
+        break;
+      default:
+        zfp_decode_block_float_4(zfp, block.f);
+        break;
+    }
+    for (i = 0; i < n; i++)
+      max = MAX(max, fabs(block.f[i]));
+  }
+  else {
+    switch (dims) {
+      case 1:
+        zfp_decode_block_double_1(zfp, block.d);
+        break;
+      case 2:
+        zfp_decode_block_double_2(zfp, block.d);
+        break;
+      case 3:
+        zfp_decode_block_double_3(zfp, block.d);
+        break;
+      default:
+        zfp_decode_block_double_4(zfp, block.d);
+        break;
+    }
+    for (i = 0; i < n; i++)
+      max = MAX(max, fabs(block.d[i]));
+  }
+
+  return max;
+}
+
 /* shared code across template instances ------------------------------------*/
 
 #include "share/parallel.c"
 #include "share/omp.c"
+#include "share/threads.c"
+
+/* number of chunks recorded in chunk index upon compression */
+static size_t
+chunk_index_count(const zfp_stream* zfp, size_t blocks)
+{
+#ifdef _OPENMP
+  if (zfp->exec.policy == zfp_exec_omp)
+    return chunk_count_omp(zfp, blocks, thread_count_omp(zfp));
+#endif
+#ifdef ZFP_WITH_THREADS
+  if (zfp->exec.policy == zfp_exec_threads)
+    return chunk_count_threads(zfp, blocks, thread_count_threads(zfp));
+#endif
+  return 1;
+}
 
 /* template instantiation of integer and float compressor -------------------*/
 
@@ -55,33 +288,173 @@ is_reversible(const zfp_stream* zfp)
 #include "template/compress.c"
 #include "template/decompress.c"
 #include "template/ompcompress.c"
+#include "template/ompdecompress.c"
 #include "template/cudacompress.c"
 #include "template/cudadecompress.c"
+#include "template/threadcompress.c"
+#include "template/threaddecompress.c"
 #undef Scalar
 
 #define Scalar int64
 #include "template/compress.c"
 #include "template/decompress.c"
 #include "template/ompcompress.c"
+#include "template/ompdecompress.c"
 #include "template/cudacompress.c"
 #include "template/cudadecompress.c"
+#include "template/threadcompress.c"
+#include "template/threaddecompress.c"
 #undef Scalar
 
 #define Scalar float
 #include "template/compress.c"
 #include "template/decompress.c"
 #include "template/ompcompress.c"
+#include "template/ompdecompress.c"
 #include "template/cudacompress.c"
 #include "template/cudadecompress.c"
+#include "template/threadcompress.c"
+#include "template/threaddecompress.c"
 #undef Scalar
 
 #define Scalar double
 #include "template/compress.c"
 #include "template/decompress.c"
 #include "template/ompcompress.c"
+#include "template/ompdecompress.c"
 #include "template/cudacompress.c"
 #include "template/cudadecompress.c"
+#include "template/threadcompress.c"
+#include "template/threaddecompress.c"
+#undef Scalar
+
+/* template instantiation of narrow floating-point compressor ---------------*/
+
+typedef uint16 half;
+typedef uint16 bfloat16;
+
+#include "traitsh.h"
+#include "template/narrowf.c"
+#include "template/narrow.c"
+#include "template/compress.c"
+#include "template/decompress.c"
+#include "template/ompcompress.c"
+#include "template/ompdecompress.c"
+#include "template/threadcompress.c"
+#include "template/threaddecompress.c"
+#undef Scalar
+#undef Codec
+#undef EBITS
+#undef MBITS
+#undef EBIAS
+
+#include "traitsb.h"
+#include "template/narrowf.c"
+#include "template/narrow.c"
+#include "template/compress.c"
+#include "template/decompress.c"
+#include "template/ompcompress.c"
+#include "template/ompdecompress.c"
+#include "template/threadcompress.c"
+#include "template/threaddecompress.c"
+#undef Scalar
+#undef Codec
+#undef EBITS
+#undef MBITS
+#undef EBIAS
+
+/* template instantiation of narrow integer compressor ----------------------*/
+
+#include "traitsu8.h"
+#include "template/narrowi.c"
+#include "template/narrow.c"
+#include "template/compress.c"
+#include "template/decompress.c"
+#include "template/ompcompress.c"
+#include "template/ompdecompress.c"
+#include "template/threadcompress.c"
+#include "template/threaddecompress.c"
+#undef Scalar
+#undef Codec
+#undef IBITS
+#undef IBIAS
+
+#include "traitsu16.h"
+#include "template/narrowi.c"
+#include "template/narrow.c"
+#include "template/compress.c"
+#include "template/decompress.c"
+#include "template/ompcompress.c"
+#include "template/ompdecompress.c"
+#include "template/threadcompress.c"
+#include "template/threaddecompress.c"
+#undef Scalar
+#undef Codec
+#undef IBITS
+#undef IBIAS
+
+#include "traitsi16.h"
+#include "template/narrowi.c"
+#include "template/narrow.c"
+#include "template/compress.c"
+#include "template/decompress.c"
+#include "template/ompcompress.c"
+#include "template/ompdecompress.c"
+#include "template/threadcompress.c"
+#include "template/threaddecompress.c"
+#undef Scalar
+#undef Codec
+#undef IBITS
+#undef IBIAS
+
+/* template instantiation of compressor with precision conversion -----------*/
+
+typedef float float_as_double;   /* float values (de)compressed as double */
+typedef double double_as_float;  /* double values (de)compressed as float */
+
+#define Scalar float_as_double
+#define Codec double
+#include "template/cast.c"
+#include "template/narrow.c"
+#include "template/compress.c"
+#include "template/decompress.c"
+#include "template/ompcompress.c"
+#include "template/ompdecompress.c"
+#include "template/threadcompress.c"
+#include "template/threaddecompress.c"
+#undef Scalar
+#undef Codec
+
+#define Scalar double_as_float
+#define Codec float
+#include "template/cast.c"
+#include "template/narrow.c"
+#include "template/compress.c"
+#include "template/decompress.c"
+#include "template/ompcompress.c"
+#include "template/ompdecompress.c"
+#include "template/threadcompress.c"
+#include "template/threaddecompress.c"
+#undef Scalar
+#undef Codec
+
+/* template instantiation of compressed-domain linear operations ------------*/
+
+#define Scalar float
+#define Int int32
+#define EBIAS 127
+#include "template/linear.c"
+#undef Scalar
+#undef Int
+#undef EBIAS
+
+#define Scalar double
+#define Int int64
+#define EBIAS 1023
+#include "template/linear.c"
 #undef Scalar
+#undef Int
+#undef EBIAS
 
 /* public functions: miscellaneous ----------------------------------------- */
 
@@ -97,6 +470,13 @@ zfp_type_size(zfp_type type)
       return sizeof(float);
     case zfp_type_double:
       return sizeof(double);
+    case zfp_type_half:
+    case zfp_type_bfloat16:
+    case zfp_type_uint16:
+    case zfp_type_int16:
+      return sizeof(uint16);
+    case zfp_type_uint8:
+      return sizeof(uint8);
     default:
       return 0;
   }
@@ -113,6 +493,8 @@ zfp_field_alloc()
     field->nx = field->ny = field->nz = field->nw = 0;
     field->sx = field->sy = field->sz = field->sw = 0;
     field->data = 0;
+    field->components = 1;
+    field->ctype = zfp_type_none;
   }
   return field;
 }
@@ -201,6 +583,12 @@ zfp_field_type(const zfp_field* field)
   return field->type;
 }
 
+zfp_type
+zfp_field_compressed_type(const zfp_field* field)
+{
+  return field->ctype ? field->ctype : default_compressed_type(field->type);
+}
+
 uint
 zfp_field_precision(const zfp_field* field)
 {
@@ -213,6 +601,12 @@ zfp_field_dimensionality(const zfp_field* field)
   return field->nx ? field->ny ? field->nz ? field->nw ? 4 : 3 : 2 : 1 : 0;
 }
 
+uint
+zfp_field_components(const zfp_field* field)
+{
+  return MAX(field->components, 1u);
+}
+
 size_t
 zfp_field_size(const zfp_field* field, size_t* size)
 {
@@ -231,7 +625,7 @@ zfp_field_size(const zfp_field* field, size_t* size)
         size[0] = field->nx;
         break;
     }
-  return MAX(field->nx, 1u) * MAX(field->ny, 1u) * MAX(field->nz, 1u) * MAX(field->nw, 1u);
+  return MAX(field->nx, 1u) * MAX(field->ny, 1u) * MAX(field->nz, 1u) * MAX(field->nw, 1u) * zfp_field_components(field);
 }
 
 size_t
@@ -243,19 +637,20 @@ zfp_field_size_bytes(const zfp_field* field)
 zfp_bool
 zfp_field_stride(const zfp_field* field, ptrdiff_t* stride)
 {
+  ptrdiff_t nc = (ptrdiff_t)zfp_field_components(field);
   if (stride)
     switch (zfp_field_dimensionality(field)) {
       case 4:
-        stride[3] = field->sw ? field->sw : (ptrdiff_t)(field->nx * field->ny * field->nz);
+        stride[3] = field->sw ? field->sw : nc * (ptrdiff_t)(field->nx * field->ny * field->nz);
         /* FALLTHROUGH */
       case 3:
-        stride[2] = field->sz ? field->sz : (ptrdiff_t)(field->nx * field->ny);
+        stride[2] = field->sz ? field->sz : nc * (ptrdiff_t)(field->nx * field->ny);
         /* FALLTHROUGH */
       case 2:
-        stride[1] = field->sy ? field->sy : (ptrdiff_t)field->nx;
+        stride[1] = field->sy ? field->sy : nc * (ptrdiff_t)field->nx;
         /* FALLTHROUGH */
       case 1:
-        stride[0] = field->sx ? field->sx : 1;
+        stride[0] = field->sx ? field->sx : nc;
         break;
     }
   return field->sx || field->sy || field->sz || field->sw;
@@ -308,8 +703,8 @@ zfp_field_metadata(const zfp_field* field)
   }
   /* 2 bits for dimensionality (1D, 2D, 3D, 4D) */
   meta <<= 2; meta += zfp_field_dimensionality(field) - 1;
-  /* 2 bits for scalar type */
-  meta <<= 2; meta += field->type - 1;
+  /* 2 bits for scalar type; values are recorded as their compressed type */
+  meta <<= 2; meta += zfp_field_compressed_type(field) - 1;
   return meta;
 }
 
@@ -327,6 +722,11 @@ zfp_field_set_type(zfp_field* field, zfp_type type)
     case zfp_type_int64:
     case zfp_type_float:
     case zfp_type_double:
+    case zfp_type_half:
+    case zfp_type_bfloat16:
+    case zfp_type_uint8:
+    case zfp_type_uint16:
+    case zfp_type_int16:
       field->type = type;
       return type;
     default:
@@ -334,6 +734,31 @@ zfp_field_set_type(zfp_field* field, zfp_type type)
   }
 }
 
+zfp_type
+zfp_field_set_compressed_type(zfp_field* field, zfp_type type)
+{
+  switch (type) {
+    case zfp_type_none:
+    case zfp_type_int32:
+    case zfp_type_int64:
+    case zfp_type_float:
+    case zfp_type_double:
+      field->ctype = type;
+      return type;
+    default:
+      return zfp_type_none;
+  }
+}
+
+uint
+zfp_field_set_components(zfp_field* field, uint components)
+{
+  if (!components || components > ZFP_MAX_COMPONENTS)
+    return 0;
+  field->components = components;
+  return components;
+}
+
 void
 zfp_field_set_size_1d(zfp_field* field, size_t n)
 {
@@ -414,6 +839,7 @@ zfp_field_set_metadata(zfp_field* field, uint64 meta)
   if (meta >> ZFP_META_BITS)
     return zfp_false;
   field->type = (zfp_type)((meta & 0x3u) + 1); meta >>= 2;
+  field->ctype = field->type;
   dims = (meta & 0x3u) + 1; meta >>= 2;
   switch (dims) {
     case 1:
@@ -443,6 +869,8 @@ zfp_field_set_metadata(zfp_field* field, uint64 meta)
       break;
   }
   field->sx = field->sy = field->sz = field->sw = 0;
+  /* metadata does not record interleaved components */
+  field->components = 1;
   return zfp_true;
 }
 
@@ -528,6 +956,9 @@ zfp_stream_open(bitstream* stream)
     zfp->maxprec = ZFP_MAX_PREC;
     zfp->minexp = ZFP_MIN_EXP;
     zfp->exec.policy = zfp_exec_serial;
+    zfp->chunk_index = zfp_false;
+    zfp->scratch = NULL;
+    zfp->scratch_size = 0;
   }
   return zfp;
 }
@@ -535,6 +966,7 @@ zfp_stream_open(bitstream* stream)
 void
 zfp_stream_close(zfp_stream* zfp)
 {
+  free(zfp->scratch);
   free(zfp);
 }
 
@@ -683,6 +1115,12 @@ zfp_stream_params(const zfp_stream* zfp, uint* minbits, uint* maxbits, uint* max
     *minexp = zfp->minexp;
 }
 
+zfp_bool
+zfp_stream_chunk_index(const zfp_stream* zfp)
+{
+  return zfp->chunk_index;
+}
+
 size_t
 zfp_stream_compressed_size(const zfp_stream* zfp)
 {
@@ -700,11 +1138,14 @@ zfp_stream_maximum_size(const zfp_stream* zfp, const zfp_field* field)
   size_t mw = (MAX(field->nw, 1u) + 3) / 4;
   size_t blocks = mx * my * mz * mw;
   uint values = 1u << (2 * dims);
+  zfp_type type = zfp_field_compressed_type(field);
+  uint precision = (uint)(CHAR_BIT * zfp_type_size(type));
   uint maxbits = 0;
+  size_t bits;
 
   if (!dims)
     return 0;
-  switch (field->type) {
+  switch (type) {
     case zfp_type_int32:
       maxbits += reversible ? 5 : 0;
       break;
@@ -720,10 +1161,125 @@ zfp_stream_maximum_size(const zfp_stream* zfp, const zfp_field* field)
     default:
       return 0;
   }
-  maxbits += values - 1 + values * MIN(zfp->maxprec, zfp_field_precision(field));
+  maxbits += values - 1 + values * MIN(zfp->maxprec, precision);
   maxbits = MIN(maxbits, zfp->maxbits);
   maxbits = MAX(maxbits, zfp->minbits);
-  return ((ZFP_HEADER_MAX_BITS + blocks * maxbits + stream_word_bits - 1) & ~(stream_word_bits - 1)) / CHAR_BIT;
+  bits = ZFP_HEADER_MAX_BITS + blocks * zfp_field_components(field) * maxbits;
+  /* account for alignment, chunk count, and chunk offsets */
+  if (zfp->chunk_index)
+    bits += stream_word_bits - 1 + 64 * (1 + chunk_index_count(zfp, blocks));
+  return ((bits + stream_word_bits - 1) & ~(stream_word_bits - 1)) / CHAR_BIT;
+}
+
+size_t
+zfp_stream_estimate_size(const zfp_stream* zfp, const zfp_field* field, double fraction, size_t* bound)
+{
+  /* function table [scalar type] */
+  size_t (*btable[11])(zfp_stream*, const zfp_field*, size_t) = {
+    compress_block_index_int32, compress_block_index_int64, compress_block_index_float, compress_block_index_double, compress_block_index_half, compress_block_index_bfloat16, compress_block_index_uint8, compress_block_index_uint16, compress_block_index_int16, compress_block_index_float_as_double, compress_block_index_double_as_float
+  };
+  size_t (*compress_block)(zfp_stream*, const zfp_field*, size_t);
+  uint dims = zfp_field_dimensionality(field);
+  size_t mx = (MAX(field->nx, 1u) + 3) / 4;
+  size_t my = (MAX(field->ny, 1u) + 3) / 4;
+  size_t mz = (MAX(field->nz, 1u) + 3) / 4;
+  size_t mw = (MAX(field->nw, 1u) + 3) / 4;
+  size_t blocks = mx * my * mz * mw;
+  size_t samples, sample;
+  double sum = 0, sum2 = 0;
+  double mean, var, bits, error;
+  ptrdiff_t stride[4] = { 0, 0, 0, 0 };
+  uint nc = zfp_field_components(field);
+  zfp_field f, g;
+  zfp_stream s;
+  bitstream* bs;
+  void* buffer;
+  size_t size;
+  int type;
+
+  type = type_index(field->type, zfp_field_compressed_type(field));
+  if (type < 0)
+    return 0;
+  compress_block = btable[type];
+  if (!dims || !(fraction > 0))
+    return 0;
+
+  /* allocate scratch stream large enough to hold any one block */
+  f = *field;
+  f.nx = f.ny = f.nz = f.nw = 0;
+  switch (dims) {
+    case 4:
+      f.nw = 4;
+      /* FALLTHROUGH */
+    case 3:
+      f.nz = 4;
+      /* FALLTHROUGH */
+    case 2:
+      f.ny = 4;
+      /* FALLTHROUGH */
+    case 1:
+      f.nx = 4;
+      break;
+  }
+  s = *zfp;
+  s.chunk_index = zfp_false;
+  size = zfp_stream_maximum_size(&s, &f);
+  buffer = malloc(size);
+  if (!buffer)
+    return 0;
+  bs = stream_open(buffer, size);
+  if (!bs) {
+    free(buffer);
+    return 0;
+  }
+  s.stream = bs;
+
+  /* view of one component with explicit strides */
+  g = *field;
+  g.components = 1;
+  zfp_field_stride(field, stride);
+  zfp_field_set_stride_4d(&g, stride[0], stride[1], stride[2], stride[3]);
+
+  /* partition blocks into equal strata and compress one block per stratum */
+  samples = (size_t)MIN(ceil(fraction * (double)blocks), (double)blocks);
+  samples = MAX(samples, 1u);
+  for (sample = 0; sample < samples; sample++) {
+    size_t begin = chunk_offset(blocks, samples, sample);
+    size_t end = chunk_offset(blocks, samples, sample + 1);
+    /* scramble position within stratum to avoid aliasing with data */
+    uint64 hash = ((uint64)sample + 1) * UINT64C(0x9e3779b97f4a7c15);
+    size_t index = begin + (size_t)((hash >> 32) % (end - begin));
+    double n = 0;
+    uint c;
+    /* interleaved components are encoded as one block per component */
+    for (c = 0; c < nc; c++) {
+      g.data = (uchar*)field->data + c * zfp_type_size(field->type);
+      stream_rewind(bs);
+      n += (double)compress_block(&s, &g, index);
+    }
+    sum += n;
+    sum2 += n * n;
+  }
+  stream_close(bs);
+  free(buffer);
+
+  /* extrapolate mean block size with finite population correction */
+  mean = sum / samples;
+  var = samples > 1 ? MAX(sum2 - sum * mean, 0.0) / (samples - 1) : 0;
+  bits = mean * blocks;
+  error = blocks * sqrt(var * (1 - (double)samples / blocks) / samples);
+
+  /* account for chunk count and chunk offsets, and bound alignment */
+  size = 0;
+  if (zfp->chunk_index)
+    size = 64 * (1 + chunk_index_count(zfp, blocks));
+  if (bound) {
+    double upper = ceil(bits + 2 * error) + size;
+    if (zfp->chunk_index)
+      upper += stream_word_bits - 1;
+    *bound = (size_t)ceil(upper / stream_word_bits) * (stream_word_bits / CHAR_BIT);
+  }
+  return (size_t)ceil((ceil(bits) + size) / stream_word_bits) * (stream_word_bits / CHAR_BIT);
 }
 
 void
@@ -748,6 +1304,8 @@ zfp_stream_set_rate(zfp_stream* zfp, double rate, zfp_type type, uint dims, zfp_
   uint bits = (uint)floor(n * rate + 0.5);
   switch (type) {
     case zfp_type_float:
+    case zfp_type_half:
+    case zfp_type_bfloat16:
       bits = MAX(bits, 1 + 8u);
       break;
     case zfp_type_double:
@@ -857,6 +1415,12 @@ zfp_stream_set_params(zfp_stream* zfp, uint minbits, uint maxbits, uint maxprec,
   return zfp_true;
 }
 
+void
+zfp_stream_set_chunk_index(zfp_stream* zfp, zfp_bool enable)
+{
+  zfp->chunk_index = enable;
+}
+
 size_t
 zfp_stream_flush(zfp_stream* zfp)
 {
@@ -895,6 +1459,18 @@ zfp_stream_omp_chunk_size(const zfp_stream* zfp)
   return zfp->exec.params.omp.chunk_size;
 }
 
+uint
+zfp_stream_thread_count(const zfp_stream* zfp)
+{
+  return zfp->exec.params.threads.threads;
+}
+
+uint
+zfp_stream_thread_chunk_size(const zfp_stream* zfp)
+{
+  return zfp->exec.params.threads.chunk_size;
+}
+
 zfp_bool
 zfp_stream_set_execution(zfp_stream* zfp, zfp_exec_policy policy)
 {
@@ -914,6 +1490,16 @@ zfp_stream_set_execution(zfp_stream* zfp, zfp_exec_policy policy)
       break;
 #else
       return zfp_false;
+#endif
+    case zfp_exec_threads:
+#ifdef ZFP_WITH_THREADS
+      if (zfp->exec.policy != policy) {
+        zfp->exec.params.threads.threads = 0;
+        zfp->exec.params.threads.chunk_size = 0;
+      }
+      break;
+#else
+      return zfp_false;
 #endif
     default:
       return zfp_false;
@@ -940,6 +1526,38 @@ zfp_stream_set_omp_chunk_size(zfp_stream* zfp, uint chunk_size)
   return zfp_true;
 }
 
+zfp_bool
+zfp_stream_set_thread_count(zfp_stream* zfp, uint threads)
+{
+  if (!zfp_stream_set_execution(zfp, zfp_exec_threads))
+    return zfp_false;
+  zfp->exec.params.threads.threads = threads;
+  return zfp_true;
+}
+
+zfp_bool
+zfp_stream_set_thread_chunk_size(zfp_stream* zfp, uint chunk_size)
+{
+  if (!zfp_stream_set_execution(zfp, zfp_exec_threads))
+    return zfp_false;
+  zfp->exec.params.threads.chunk_size = chunk_size;
+  return zfp_true;
+}
+
+size_t
+zfp_stream_scratch_size(const zfp_stream* zfp)
+{
+  return zfp->scratch_size;
+}
+
+void
+zfp_stream_release_scratch(zfp_stream* zfp)
+{
+  free(zfp->scratch);
+  zfp->scratch = NULL;
+  zfp->scratch_size = 0;
+}
+
 /* public functions: utility functions --------------------------------------*/
 
 void
@@ -1020,70 +1638,204 @@ size_t
 zfp_compress(zfp_stream* zfp, const zfp_field* field)
 {
   /* function table [execution][strided][dimensionality][scalar type] */
-  void (*ftable[3][2][4][4])(zfp_stream*, const zfp_field*) = {
+  void (*ftable[4][2][4][11])(zfp_stream*, const zfp_field*) = {
     /* serial */
-    {{{ compress_int32_1,         compress_int64_1,         compress_float_1,         compress_double_1 },
-      { compress_strided_int32_2, compress_strided_int64_2, compress_strided_float_2, compress_strided_double_2 },
-      { compress_strided_int32_3, compress_strided_int64_3, compress_strided_float_3, compress_strided_double_3 },
-      { compress_strided_int32_4, compress_strided_int64_4, compress_strided_float_4, compress_strided_double_4 }},
-     {{ compress_strided_int32_1, compress_strided_int64_1, compress_strided_float_1, compress_strided_double_1 },
-      { compress_strided_int32_2, compress_strided_int64_2, compress_strided_float_2, compress_strided_double_2 },
-      { compress_strided_int32_3, compress_strided_int64_3, compress_strided_float_3, compress_strided_double_3 },
-      { compress_strided_int32_4, compress_strided_int64_4, compress_strided_float_4, compress_strided_double_4 }}},
+    {{{ compress_int32_1,         compress_int64_1,         compress_float_1,         compress_double_1,         compress_half_1,         compress_bfloat16_1, compress_uint8_1, compress_uint16_1, compress_int16_1, compress_float_as_double_1, compress_double_as_float_1 },
+      { compress_strided_int32_2, compress_strided_int64_2, compress_strided_float_2, compress_strided_double_2, compress_strided_half_2, compress_strided_bfloat16_2, compress_strided_uint8_2, compress_strided_uint16_2, compress_strided_int16_2, compress_strided_float_as_double_2, compress_strided_double_as_float_2 },
+      { compress_strided_int32_3, compress_strided_int64_3, compress_strided_float_3, compress_strided_double_3, compress_strided_half_3, compress_strided_bfloat16_3, compress_strided_uint8_3, compress_strided_uint16_3, compress_strided_int16_3, compress_strided_float_as_double_3, compress_strided_double_as_float_3 },
+      { compress_strided_int32_4, compress_strided_int64_4, compress_strided_float_4, compress_strided_double_4, compress_strided_half_4, compress_strided_bfloat16_4, compress_strided_uint8_4, compress_strided_uint16_4, compress_strided_int16_4, compress_strided_float_as_double_4, compress_strided_double_as_float_4 }},
+     {{ compress_strided_int32_1, compress_strided_int64_1, compress_strided_float_1, compress_strided_double_1, compress_strided_half_1, compress_strided_bfloat16_1, compress_strided_uint8_1, compress_strided_uint16_1, compress_strided_int16_1, compress_strided_float_as_double_1, compress_strided_double_as_float_1 },
+      { compress_strided_int32_2, compress_strided_int64_2, compress_strided_float_2, compress_strided_double_2, compress_strided_half_2, compress_strided_bfloat16_2, compress_strided_uint8_2, compress_strided_uint16_2, compress_strided_int16_2, compress_strided_float_as_double_2, compress_strided_double_as_float_2 },
+      { compress_strided_int32_3, compress_strided_int64_3, compress_strided_float_3, compress_strided_double_3, compress_strided_half_3, compress_strided_bfloat16_3, compress_strided_uint8_3, compress_strided_uint16_3, compress_strided_int16_3, compress_strided_float_as_double_3, compress_strided_double_as_float_3 },
+      { compress_strided_int32_4, compress_strided_int64_4, compress_strided_float_4, compress_strided_double_4, compress_strided_half_4, compress_strided_bfloat16_4, compress_strided_uint8_4, compress_strided_uint16_4, compress_strided_int16_4, compress_strided_float_as_double_4, compress_strided_double_as_float_4 }}},
 
     /* OpenMP */
 #ifdef _OPENMP
-    {{{ compress_omp_int32_1,         compress_omp_int64_1,         compress_omp_float_1,         compress_omp_double_1 },
-      { compress_strided_omp_int32_2, compress_strided_omp_int64_2, compress_strided_omp_float_2, compress_strided_omp_double_2 },
-      { compress_strided_omp_int32_3, compress_strided_omp_int64_3, compress_strided_omp_float_3, compress_strided_omp_double_3 },
-      { compress_strided_omp_int32_4, compress_strided_omp_int64_4, compress_strided_omp_float_4, compress_strided_omp_double_4 }},
-     {{ compress_strided_omp_int32_1, compress_strided_omp_int64_1, compress_strided_omp_float_1, compress_strided_omp_double_1 },
-      { compress_strided_omp_int32_2, compress_strided_omp_int64_2, compress_strided_omp_float_2, compress_strided_omp_double_2 },
-      { compress_strided_omp_int32_3, compress_strided_omp_int64_3, compress_strided_omp_float_3, compress_strided_omp_double_3 },
-      { compress_strided_omp_int32_4, compress_strided_omp_int64_4, compress_strided_omp_float_4, compress_strided_omp_double_4 }}},
+    {{{ compress_omp_int32_1,         compress_omp_int64_1,         compress_omp_float_1,         compress_omp_double_1,         compress_omp_half_1,         compress_omp_bfloat16_1, compress_omp_uint8_1, compress_omp_uint16_1, compress_omp_int16_1, compress_omp_float_as_double_1, compress_omp_double_as_float_1 },
+      { compress_strided_omp_int32_2, compress_strided_omp_int64_2, compress_strided_omp_float_2, compress_strided_omp_double_2, compress_strided_omp_half_2, compress_strided_omp_bfloat16_2, compress_strided_omp_uint8_2, compress_strided_omp_uint16_2, compress_strided_omp_int16_2, compress_strided_omp_float_as_double_2, compress_strided_omp_double_as_float_2 },
+      { compress_strided_omp_int32_3, compress_strided_omp_int64_3, compress_strided_omp_float_3, compress_strided_omp_double_3, compress_strided_omp_half_3, compress_strided_omp_bfloat16_3, compress_strided_omp_uint8_3, compress_strided_omp_uint16_3, compress_strided_omp_int16_3, compress_strided_omp_float_as_double_3, compress_strided_omp_double_as_float_3 },
+      { compress_strided_omp_int32_4, compress_strided_omp_int64_4, compress_strided_omp_float_4, compress_strided_omp_double_4, compress_strided_omp_half_4, compress_strided_omp_bfloat16_4, compress_strided_omp_uint8_4, compress_strided_omp_uint16_4, compress_strided_omp_int16_4, compress_strided_omp_float_as_double_4, compress_strided_omp_double_as_float_4 }},
+     {{ compress_strided_omp_int32_1, compress_strided_omp_int64_1, compress_strided_omp_float_1, compress_strided_omp_double_1, compress_strided_omp_half_1, compress_strided_omp_bfloat16_1, compress_strided_omp_uint8_1, compress_strided_omp_uint16_1, compress_strided_omp_int16_1, compress_strided_omp_float_as_double_1, compress_strided_omp_double_as_float_1 },
+      { compress_strided_omp_int32_2, compress_strided_omp_int64_2, compress_strided_omp_float_2, compress_strided_omp_double_2, compress_strided_omp_half_2, compress_strided_omp_bfloat16_2, compress_strided_omp_uint8_2, compress_strided_omp_uint16_2, compress_strided_omp_int16_2, compress_strided_omp_float_as_double_2, compress_strided_omp_double_as_float_2 },
+      { compress_strided_omp_int32_3, compress_strided_omp_int64_3, compress_strided_omp_float_3, compress_strided_omp_double_3, compress_strided_omp_half_3, compress_strided_omp_bfloat16_3, compress_strided_omp_uint8_3, compress_strided_omp_uint16_3, compress_strided_omp_int16_3, compress_strided_omp_float_as_double_3, compress_strided_omp_double_as_float_3 },
+      { compress_strided_omp_int32_4, compress_strided_omp_int64_4, compress_strided_omp_float_4, compress_strided_omp_double_4, compress_strided_omp_half_4, compress_strided_omp_bfloat16_4, compress_strided_omp_uint8_4, compress_strided_omp_uint16_4, compress_strided_omp_int16_4, compress_strided_omp_float_as_double_4, compress_strided_omp_double_as_float_4 }}},
 #else
     {{{ NULL }}},
 #endif
 
     /* CUDA */
 #ifdef ZFP_WITH_CUDA
-    {{{ compress_cuda_int32_1,         compress_cuda_int64_1,         compress_cuda_float_1,         compress_cuda_double_1 },
-      { compress_strided_cuda_int32_2, compress_strided_cuda_int64_2, compress_strided_cuda_float_2, compress_strided_cuda_double_2 },
-      { compress_strided_cuda_int32_3, compress_strided_cuda_int64_3, compress_strided_cuda_float_3, compress_strided_cuda_double_3 },
-      { NULL,                            NULL,                            NULL,                            NULL }},
-     {{ compress_strided_cuda_int32_1, compress_strided_cuda_int64_1, compress_strided_cuda_float_1, compress_strided_cuda_double_1 },
-      { compress_strided_cuda_int32_2, compress_strided_cuda_int64_2, compress_strided_cuda_float_2, compress_strided_cuda_double_2 },
-      { compress_strided_cuda_int32_3, compress_strided_cuda_int64_3, compress_strided_cuda_float_3, compress_strided_cuda_double_3 },
-      { NULL,                            NULL,                            NULL,                            NULL }}},
+    {{{ compress_cuda_int32_1,         compress_cuda_int64_1,         compress_cuda_float_1,         compress_cuda_double_1,         NULL, NULL, NULL, NULL, NULL, NULL, NULL },
+      { compress_strided_cuda_int32_2, compress_strided_cuda_int64_2, compress_strided_cuda_float_2, compress_strided_cuda_double_2, NULL, NULL, NULL, NULL, NULL, NULL, NULL },
+      { compress_strided_cuda_int32_3, compress_strided_cuda_int64_3, compress_strided_cuda_float_3, compress_strided_cuda_double_3, NULL, NULL, NULL, NULL, NULL, NULL, NULL },
+      { NULL,                          NULL,                          NULL,                          NULL,                           NULL, NULL, NULL, NULL, NULL, NULL, NULL }},
+     {{ compress_strided_cuda_int32_1, compress_strided_cuda_int64_1, compress_strided_cuda_float_1, compress_strided_cuda_double_1, NULL, NULL, NULL, NULL, NULL, NULL, NULL },
+      { compress_strided_cuda_int32_2, compress_strided_cuda_int64_2, compress_strided_cuda_float_2, compress_strided_cuda_double_2, NULL, NULL, NULL, NULL, NULL, NULL, NULL },
+      { compress_strided_cuda_int32_3, compress_strided_cuda_int64_3, compress_strided_cuda_float_3, compress_strided_cuda_double_3, NULL, NULL, NULL, NULL, NULL, NULL, NULL },
+      { NULL,                          NULL,                          NULL,                          NULL,                           NULL, NULL, NULL, NULL, NULL, NULL, NULL }}},
 #else
     {{{ NULL }}},
 #endif
+
+    /* native threads */
+#ifdef ZFP_WITH_THREADS
+    {{{ compress_strided_threads_int32_1, compress_strided_threads_int64_1, compress_strided_threads_float_1, compress_strided_threads_double_1, compress_strided_threads_half_1, compress_strided_threads_bfloat16_1, compress_strided_threads_uint8_1, compress_strided_threads_uint16_1, compress_strided_threads_int16_1, compress_strided_threads_float_as_double_1, compress_strided_threads_double_as_float_1 },
+      { compress_strided_threads_int32_2, compress_strided_threads_int64_2, compress_strided_threads_float_2, compress_strided_threads_double_2, compress_strided_threads_half_2, compress_strided_threads_bfloat16_2, compress_strided_threads_uint8_2, compress_strided_threads_uint16_2, compress_strided_threads_int16_2, compress_strided_threads_float_as_double_2, compress_strided_threads_double_as_float_2 },
+      { compress_strided_threads_int32_3, compress_strided_threads_int64_3, compress_strided_threads_float_3, compress_strided_threads_double_3, compress_strided_threads_half_3, compress_strided_threads_bfloat16_3, compress_strided_threads_uint8_3, compress_strided_threads_uint16_3, compress_strided_threads_int16_3, compress_strided_threads_float_as_double_3, compress_strided_threads_double_as_float_3 },
+      { compress_strided_threads_int32_4, compress_strided_threads_int64_4, compress_strided_threads_float_4, compress_strided_threads_double_4, compress_strided_threads_half_4, compress_strided_threads_bfloat16_4, compress_strided_threads_uint8_4, compress_strided_threads_uint16_4, compress_strided_threads_int16_4, compress_strided_threads_float_as_double_4, compress_strided_threads_double_as_float_4 }},
+     {{ compress_strided_threads_int32_1, compress_strided_threads_int64_1, compress_strided_threads_float_1, compress_strided_threads_double_1, compress_strided_threads_half_1, compress_strided_threads_bfloat16_1, compress_strided_threads_uint8_1, compress_strided_threads_uint16_1, compress_strided_threads_int16_1, compress_strided_threads_float_as_double_1, compress_strided_threads_double_as_float_1 },
+      { compress_strided_threads_int32_2, compress_strided_threads_int64_2, compress_strided_threads_float_2, compress_strided_threads_double_2, compress_strided_threads_half_2, compress_strided_threads_bfloat16_2, compress_strided_threads_uint8_2, compress_strided_threads_uint16_2, compress_strided_threads_int16_2, compress_strided_threads_float_as_double_2, compress_strided_threads_double_as_float_2 },
+      { compress_strided_threads_int32_3, compress_strided_threads_int64_3, compress_strided_threads_float_3, compress_strided_threads_double_3, compress_strided_threads_half_3, compress_strided_threads_bfloat16_3, compress_strided_threads_uint8_3, compress_strided_threads_uint16_3, compress_strided_threads_int16_3, compress_strided_threads_float_as_double_3, compress_strided_threads_double_as_float_3 },
+      { compress_strided_threads_int32_4, compress_strided_threads_int64_4, compress_strided_threads_float_4, compress_strided_threads_double_4, compress_strided_threads_half_4, compress_strided_threads_bfloat16_4, compress_strided_threads_uint8_4, compress_strided_threads_uint16_4, compress_strided_threads_int16_4, compress_strided_threads_float_as_double_4, compress_strided_threads_double_as_float_4 }}},
+#else
+    {{{ NULL }}},
+#endif
+  };
+  /* function table [scalar type] for interleaved components */
+  void (*ctable[11])(zfp_stream*, const zfp_field*) = {
+    compress_components_int32, compress_components_int64, compress_components_float, compress_components_double, compress_components_half, compress_components_bfloat16, compress_components_uint8, compress_components_uint16, compress_components_int16, compress_components_float_as_double, compress_components_double_as_float
   };
   uint exec = zfp->exec.policy;
   uint strided = zfp_field_stride(field, NULL);
   uint dims = zfp_field_dimensionality(field);
-  uint type = field->type;
+  int type = type_index(field->type, zfp_field_compressed_type(field));
   void (*compress)(zfp_stream*, const zfp_field*);
 
-  switch (type) {
-    case zfp_type_int32:
-    case zfp_type_int64:
-    case zfp_type_float:
-    case zfp_type_double:
-      break;
-    default:
-      return 0;
-  }
+  if (type < 0)
+    return 0;
 
-  /* return 0 if compression mode is not supported */
-  compress = ftable[exec][strided][dims - 1][type - zfp_type_int32];
+  /* return 0 if compression mode is not supported; interleaved components are
+     compressed serially */
+  if (zfp_field_components(field) > 1)
+    compress = exec == zfp_exec_serial ? ctable[type] : NULL;
+  else
+    compress = ftable[exec][strided][dims - 1][type];
   if (!compress)
     return 0;
 
+  /* callback streams support only sequential serial compression */
+  if (exec != zfp_exec_serial && stream_is_callback(zfp->stream))
+    return 0;
+
+  /* serial compression records all blocks as one chunk; parallel compression
+     records its own chunk index */
+  if (zfp->chunk_index)
+    switch (exec) {
+      case zfp_exec_serial:
+        chunk_index_begin(zfp->stream, 1);
+        chunk_index_append(zfp->stream, 0);
+        break;
+      case zfp_exec_omp:
+      case zfp_exec_threads:
+        break;
+      default:
+        return 0;
+    }
+
   /* compress field and align bit stream on word boundary */
   compress(zfp, field);
   stream_flush(zfp->stream);
 
+  /* fail if words could not be drained to sink */
+  if (stream_error(zfp->stream))
+    return 0;
+
+  return stream_size(zfp->stream);
+}
+
+zfp_slab_cursor*
+zfp_compress_begin(zfp_stream* zfp, const zfp_field* field)
+{
+  zfp_slab_cursor* cursor = slab_cursor_open(zfp, field, zfp_true);
+  if (!cursor)
+    return NULL;
+
+  /* record all blocks as one chunk, as in serial zfp_compress */
+  if (zfp->chunk_index) {
+    chunk_index_begin(zfp->stream, 1);
+    chunk_index_append(zfp->stream, 0);
+  }
+
+  return cursor;
+}
+
+zfp_bool
+zfp_compress_slab(zfp_slab_cursor* cursor, const void* data, size_t planes)
+{
+  /* function table [strided][dimensionality][scalar type] */
+  void (*ftable[2][4][11])(zfp_stream*, const zfp_field*) = {
+    {{ compress_int32_1,         compress_int64_1,         compress_float_1,         compress_double_1,         compress_half_1,         compress_bfloat16_1, compress_uint8_1, compress_uint16_1, compress_int16_1, compress_float_as_double_1, compress_double_as_float_1 },
+     { compress_strided_int32_2, compress_strided_int64_2, compress_strided_float_2, compress_strided_double_2, compress_strided_half_2, compress_strided_bfloat16_2, compress_strided_uint8_2, compress_strided_uint16_2, compress_strided_int16_2, compress_strided_float_as_double_2, compress_strided_double_as_float_2 },
+     { compress_strided_int32_3, compress_strided_int64_3, compress_strided_float_3, compress_strided_double_3, compress_strided_half_3, compress_strided_bfloat16_3, compress_strided_uint8_3, compress_strided_uint16_3, compress_strided_int16_3, compress_strided_float_as_double_3, compress_strided_double_as_float_3 },
+     { compress_strided_int32_4, compress_strided_int64_4, compress_strided_float_4, compress_strided_double_4, compress_strided_half_4, compress_strided_bfloat16_4, compress_strided_uint8_4, compress_strided_uint16_4, compress_strided_int16_4, compress_strided_float_as_double_4, compress_strided_double_as_float_4 }},
+    {{ compress_strided_int32_1, compress_strided_int64_1, compress_strided_float_1, compress_strided_double_1, compress_strided_half_1, compress_strided_bfloat16_1, compress_strided_uint8_1, compress_strided_uint16_1, compress_strided_int16_1, compress_strided_float_as_double_1, compress_strided_double_as_float_1 },
+     { compress_strided_int32_2, compress_strided_int64_2, compress_strided_float_2, compress_strided_double_2, compress_strided_half_2, compress_strided_bfloat16_2, compress_strided_uint8_2, compress_strided_uint16_2, compress_strided_int16_2, compress_strided_float_as_double_2, compress_strided_double_as_float_2 },
+     { compress_strided_int32_3, compress_strided_int64_3, compress_strided_float_3, compress_strided_double_3, compress_strided_half_3, compress_strided_bfloat16_3, compress_strided_uint8_3, compress_strided_uint16_3, compress_strided_int16_3, compress_strided_float_as_double_3, compress_strided_double_as_float_3 },
+     { compress_strided_int32_4, compress_strided_int64_4, compress_strided_float_4, compress_strided_double_4, compress_strided_half_4, compress_strided_bfloat16_4, compress_strided_uint8_4, compress_strided_uint16_4, compress_strided_int16_4, compress_strided_float_as_double_4, compress_strided_double_as_float_4 }},
+  };
+  /* function table [scalar type] for interleaved components */
+  void (*ctable[11])(zfp_stream*, const zfp_field*) = {
+    compress_components_int32, compress_components_int64, compress_components_float, compress_components_double, compress_components_half, compress_components_bfloat16, compress_components_uint8, compress_components_uint16, compress_components_int16, compress_components_float_as_double, compress_components_double_as_float
+  };
+  zfp_stream* zfp;
+  const zfp_field* field;
+  zfp_field slab;
+  size_t* n;
+  uint strided;
+  uint dims;
+  int type;
+
+  if (!cursor || !cursor->compress)
+    return zfp_false;
+  zfp = cursor->stream;
+  field = &cursor->field;
+
+  /* slab is field restricted to planes along its slowest varying dimension */
+  slab = *field;
+  slab.data = (void*)data;
+  dims = zfp_field_dimensionality(field);
+  n = field_plane_count(&slab);
+
+  /* blocks may not straddle slabs, so only the last slab may be partial */
+  if (!planes || planes > *n - cursor->plane || (planes % 4 && planes != *n - cursor->plane))
+    return zfp_false;
+  *n = planes;
+
+  /* compress whole blocks of slab in same order as zfp_compress */
+  strided = zfp_field_stride(field, NULL);
+  type = type_index(field->type, zfp_field_compressed_type(field));
+  if (zfp_field_components(field) > 1)
+    ctable[type](zfp, &slab);
+  else
+    ftable[strided][dims - 1][type](zfp, &slab);
+  cursor->plane += planes;
+
+  return zfp_true;
+}
+
+size_t
+zfp_compress_end(zfp_slab_cursor* cursor)
+{
+  zfp_stream* zfp;
+  zfp_bool complete;
+
+  if (!cursor || !cursor->compress)
+    return 0;
+  zfp = cursor->stream;
+  complete = (cursor->plane == *field_plane_count(&cursor->field));
+  free(cursor);
+
+  /* all planes of field must have been compressed */
+  if (!complete)
+    return 0;
+
+  /* align bit stream on word boundary */
+  stream_flush(zfp->stream);
+
+  /* fail if words could not be drained to sink */
+  if (stream_error(zfp->stream))
+    return 0;
+
   return stream_size(zfp->stream);
 }
 
@@ -1091,60 +1843,403 @@ size_t
 zfp_decompress(zfp_stream* zfp, zfp_field* field)
 {
   /* function table [execution][strided][dimensionality][scalar type] */
-  void (*ftable[3][2][4][4])(zfp_stream*, zfp_field*) = {
+  void (*ftable[4][2][4][11])(zfp_stream*, zfp_field*) = {
     /* serial */
-    {{{ decompress_int32_1,         decompress_int64_1,         decompress_float_1,         decompress_double_1 },
-      { decompress_strided_int32_2, decompress_strided_int64_2, decompress_strided_float_2, decompress_strided_double_2 },
-      { decompress_strided_int32_3, decompress_strided_int64_3, decompress_strided_float_3, decompress_strided_double_3 },
-      { decompress_strided_int32_4, decompress_strided_int64_4, decompress_strided_float_4, decompress_strided_double_4 }},
-     {{ decompress_strided_int32_1, decompress_strided_int64_1, decompress_strided_float_1, decompress_strided_double_1 },
-      { decompress_strided_int32_2, decompress_strided_int64_2, decompress_strided_float_2, decompress_strided_double_2 },
-      { decompress_strided_int32_3, decompress_strided_int64_3, decompress_strided_float_3, decompress_strided_double_3 },
-      { decompress_strided_int32_4, decompress_strided_int64_4, decompress_strided_float_4, decompress_strided_double_4 }}},
-
-    /* OpenMP; not yet supported */
+    {{{ decompress_int32_1,         decompress_int64_1,         decompress_float_1,         decompress_double_1,         decompress_half_1,         decompress_bfloat16_1, decompress_uint8_1, decompress_uint16_1, decompress_int16_1, decompress_float_as_double_1, decompress_double_as_float_1 },
+      { decompress_strided_int32_2, decompress_strided_int64_2, decompress_strided_float_2, decompress_strided_double_2, decompress_strided_half_2, decompress_strided_bfloat16_2, decompress_strided_uint8_2, decompress_strided_uint16_2, decompress_strided_int16_2, decompress_strided_float_as_double_2, decompress_strided_double_as_float_2 },
+      { decompress_strided_int32_3, decompress_strided_int64_3, decompress_strided_float_3, decompress_strided_double_3, decompress_strided_half_3, decompress_strided_bfloat16_3, decompress_strided_uint8_3, decompress_strided_uint16_3, decompress_strided_int16_3, decompress_strided_float_as_double_3, decompress_strided_double_as_float_3 },
+      { decompress_strided_int32_4, decompress_strided_int64_4, decompress_strided_float_4, decompress_strided_double_4, decompress_strided_half_4, decompress_strided_bfloat16_4, decompress_strided_uint8_4, decompress_strided_uint16_4, decompress_strided_int16_4, decompress_strided_float_as_double_4, decompress_strided_double_as_float_4 }},
+     {{ decompress_strided_int32_1, decompress_strided_int64_1, decompress_strided_float_1, decompress_strided_double_1, decompress_strided_half_1, decompress_strided_bfloat16_1, decompress_strided_uint8_1, decompress_strided_uint16_1, decompress_strided_int16_1, decompress_strided_float_as_double_1, decompress_strided_double_as_float_1 },
+      { decompress_strided_int32_2, decompress_strided_int64_2, decompress_strided_float_2, decompress_strided_double_2, decompress_strided_half_2, decompress_strided_bfloat16_2, decompress_strided_uint8_2, decompress_strided_uint16_2, decompress_strided_int16_2, decompress_strided_float_as_double_2, decompress_strided_double_as_float_2 },
+      { decompress_strided_int32_3, decompress_strided_int64_3, decompress_strided_float_3, decompress_strided_double_3, decompress_strided_half_3, decompress_strided_bfloat16_3, decompress_strided_uint8_3, decompress_strided_uint16_3, decompress_strided_int16_3, decompress_strided_float_as_double_3, decompress_strided_double_as_float_3 },
+      { decompress_strided_int32_4, decompress_strided_int64_4, decompress_strided_float_4, decompress_strided_double_4, decompress_strided_half_4, decompress_strided_bfloat16_4, decompress_strided_uint8_4, decompress_strided_uint16_4, decompress_strided_int16_4, decompress_strided_float_as_double_4, decompress_strided_double_as_float_4 }}},
+
+    /* OpenMP; see ptable */
     {{{ NULL }}},
 
     /* CUDA */
 #ifdef ZFP_WITH_CUDA
-    {{{ decompress_cuda_int32_1,         decompress_cuda_int64_1,         decompress_cuda_float_1,         decompress_cuda_double_1 },
-      { decompress_strided_cuda_int32_2, decompress_strided_cuda_int64_2, decompress_strided_cuda_float_2, decompress_strided_cuda_double_2 },
-      { decompress_strided_cuda_int32_3, decompress_strided_cuda_int64_3, decompress_strided_cuda_float_3, decompress_strided_cuda_double_3 },
-      { NULL,                            NULL,                            NULL,                            NULL }},
-     {{ decompress_strided_cuda_int32_1, decompress_strided_cuda_int64_1, decompress_strided_cuda_float_1, decompress_strided_cuda_double_1 },
-      { decompress_strided_cuda_int32_2, decompress_strided_cuda_int64_2, decompress_strided_cuda_float_2, decompress_strided_cuda_double_2 },
-      { decompress_strided_cuda_int32_3, decompress_strided_cuda_int64_3, decompress_strided_cuda_float_3, decompress_strided_cuda_double_3 },
-      { NULL,                            NULL,                            NULL,                            NULL }}},
+    {{{ decompress_cuda_int32_1,         decompress_cuda_int64_1,         decompress_cuda_float_1,         decompress_cuda_double_1,         NULL, NULL, NULL, NULL, NULL, NULL, NULL },
+      { decompress_strided_cuda_int32_2, decompress_strided_cuda_int64_2, decompress_strided_cuda_float_2, decompress_strided_cuda_double_2, NULL, NULL, NULL, NULL, NULL, NULL, NULL },
+      { decompress_strided_cuda_int32_3, decompress_strided_cuda_int64_3, decompress_strided_cuda_float_3, decompress_strided_cuda_double_3, NULL, NULL, NULL, NULL, NULL, NULL, NULL },
+      { NULL,                            NULL,                            NULL,                            NULL,                             NULL, NULL, NULL, NULL, NULL, NULL, NULL }},
+     {{ decompress_strided_cuda_int32_1, decompress_strided_cuda_int64_1, decompress_strided_cuda_float_1, decompress_strided_cuda_double_1, NULL, NULL, NULL, NULL, NULL, NULL, NULL },
+      { decompress_strided_cuda_int32_2, decompress_strided_cuda_int64_2, decompress_strided_cuda_float_2, decompress_strided_cuda_double_2, NULL, NULL, NULL, NULL, NULL, NULL, NULL },
+      { decompress_strided_cuda_int32_3, decompress_strided_cuda_int64_3, decompress_strided_cuda_float_3, decompress_strided_cuda_double_3, NULL, NULL, NULL, NULL, NULL, NULL, NULL },
+      { NULL,                            NULL,                            NULL,                            NULL,                             NULL, NULL, NULL, NULL, NULL, NULL, NULL }}},
 #else
     {{{ NULL }}},
 #endif
+
+    /* native threads; see ptable */
+    {{{ NULL }}},
+  };
+  /* function table [execution][strided][dimensionality][scalar type] for
+     parallel decompressors, which fail on a corrupt chunk index or when
+     memory cannot be allocated */
+  zfp_bool (*ptable[2][2][4][11])(zfp_stream*, zfp_field*) = {
+    /* OpenMP; fixed-rate only */
+#ifdef _OPENMP
+    {{{ decompress_omp_int32_1,         decompress_omp_int64_1,         decompress_omp_float_1,         decompress_omp_double_1,         decompress_omp_half_1,         decompress_omp_bfloat16_1, decompress_omp_uint8_1, decompress_omp_uint16_1, decompress_omp_int16_1, decompress_omp_float_as_double_1, decompress_omp_double_as_float_1 },
+      { decompress_strided_omp_int32_2, decompress_strided_omp_int64_2, decompress_strided_omp_float_2, decompress_strided_omp_double_2, decompress_strided_omp_half_2, decompress_strided_omp_bfloat16_2, decompress_strided_omp_uint8_2, decompress_strided_omp_uint16_2, decompress_strided_omp_int16_2, decompress_strided_omp_float_as_double_2, decompress_strided_omp_double_as_float_2 },
+      { decompress_strided_omp_int32_3, decompress_strided_omp_int64_3, decompress_strided_omp_float_3, decompress_strided_omp_double_3, decompress_strided_omp_half_3, decompress_strided_omp_bfloat16_3, decompress_strided_omp_uint8_3, decompress_strided_omp_uint16_3, decompress_strided_omp_int16_3, decompress_strided_omp_float_as_double_3, decompress_strided_omp_double_as_float_3 },
+      { decompress_strided_omp_int32_4, decompress_strided_omp_int64_4, decompress_strided_omp_float_4, decompress_strided_omp_double_4, decompress_strided_omp_half_4, decompress_strided_omp_bfloat16_4, decompress_strided_omp_uint8_4, decompress_strided_omp_uint16_4, decompress_strided_omp_int16_4, decompress_strided_omp_float_as_double_4, decompress_strided_omp_double_as_float_4 }},
+     {{ decompress_strided_omp_int32_1, decompress_strided_omp_int64_1, decompress_strided_omp_float_1, decompress_strided_omp_double_1, decompress_strided_omp_half_1, decompress_strided_omp_bfloat16_1, decompress_strided_omp_uint8_1, decompress_strided_omp_uint16_1, decompress_strided_omp_int16_1, decompress_strided_omp_float_as_double_1, decompress_strided_omp_double_as_float_1 },
+      { decompress_strided_omp_int32_2, decompress_strided_omp_int64_2, decompress_strided_omp_float_2, decompress_strided_omp_double_2, decompress_strided_omp_half_2, decompress_strided_omp_bfloat16_2, decompress_strided_omp_uint8_2, decompress_strided_omp_uint16_2, decompress_strided_omp_int16_2, decompress_strided_omp_float_as_double_2, decompress_strided_omp_double_as_float_2 },
+      { decompress_strided_omp_int32_3, decompress_strided_omp_int64_3, decompress_strided_omp_float_3, decompress_strided_omp_double_3, decompress_strided_omp_half_3, decompress_strided_omp_bfloat16_3, decompress_strided_omp_uint8_3, decompress_strided_omp_uint16_3, decompress_strided_omp_int16_3, decompress_strided_omp_float_as_double_3, decompress_strided_omp_double_as_float_3 },
+      { decompress_strided_omp_int32_4, decompress_strided_omp_int64_4, decompress_strided_omp_float_4, decompress_strided_omp_double_4, decompress_strided_omp_half_4, decompress_strided_omp_bfloat16_4, decompress_strided_omp_uint8_4, decompress_strided_omp_uint16_4, decompress_strided_omp_int16_4, decompress_strided_omp_float_as_double_4, decompress_strided_omp_double_as_float_4 }}},
+#else
+    {{{ NULL }}},
+#endif
+
+    /* native threads; fixed-rate or chunk index only */
+#ifdef ZFP_WITH_THREADS
+    {{{ decompress_strided_threads_int32_1, decompress_strided_threads_int64_1, decompress_strided_threads_float_1, decompress_strided_threads_double_1, decompress_strided_threads_half_1, decompress_strided_threads_bfloat16_1, decompress_strided_threads_uint8_1, decompress_strided_threads_uint16_1, decompress_strided_threads_int16_1, decompress_strided_threads_float_as_double_1, decompress_strided_threads_double_as_float_1 },
+      { decompress_strided_threads_int32_2, decompress_strided_threads_int64_2, decompress_strided_threads_float_2, decompress_strided_threads_double_2, decompress_strided_threads_half_2, decompress_strided_threads_bfloat16_2, decompress_strided_threads_uint8_2, decompress_strided_threads_uint16_2, decompress_strided_threads_int16_2, decompress_strided_threads_float_as_double_2, decompress_strided_threads_double_as_float_2 },
+      { decompress_strided_threads_int32_3, decompress_strided_threads_int64_3, decompress_strided_threads_float_3, decompress_strided_threads_double_3, decompress_strided_threads_half_3, decompress_strided_threads_bfloat16_3, decompress_strided_threads_uint8_3, decompress_strided_threads_uint16_3, decompress_strided_threads_int16_3, decompress_strided_threads_float_as_double_3, decompress_strided_threads_double_as_float_3 },
+      { decompress_strided_threads_int32_4, decompress_strided_threads_int64_4, decompress_strided_threads_float_4, decompress_strided_threads_double_4, decompress_strided_threads_half_4, decompress_strided_threads_bfloat16_4, decompress_strided_threads_uint8_4, decompress_strided_threads_uint16_4, decompress_strided_threads_int16_4, decompress_strided_threads_float_as_double_4, decompress_strided_threads_double_as_float_4 }},
+     {{ decompress_strided_threads_int32_1, decompress_strided_threads_int64_1, decompress_strided_threads_float_1, decompress_strided_threads_double_1, decompress_strided_threads_half_1, decompress_strided_threads_bfloat16_1, decompress_strided_threads_uint8_1, decompress_strided_threads_uint16_1, decompress_strided_threads_int16_1, decompress_strided_threads_float_as_double_1, decompress_strided_threads_double_as_float_1 },
+      { decompress_strided_threads_int32_2, decompress_strided_threads_int64_2, decompress_strided_threads_float_2, decompress_strided_threads_double_2, decompress_strided_threads_half_2, decompress_strided_threads_bfloat16_2, decompress_strided_threads_uint8_2, decompress_strided_threads_uint16_2, decompress_strided_threads_int16_2, decompress_strided_threads_float_as_double_2, decompress_strided_threads_double_as_float_2 },
+      { decompress_strided_threads_int32_3, decompress_strided_threads_int64_3, decompress_strided_threads_float_3, decompress_strided_threads_double_3, decompress_strided_threads_half_3, decompress_strided_threads_bfloat16_3, decompress_strided_threads_uint8_3, decompress_strided_threads_uint16_3, decompress_strided_threads_int16_3, decompress_strided_threads_float_as_double_3, decompress_strided_threads_double_as_float_3 },
+      { decompress_strided_threads_int32_4, decompress_strided_threads_int64_4, decompress_strided_threads_float_4, decompress_strided_threads_double_4, decompress_strided_threads_half_4, decompress_strided_threads_bfloat16_4, decompress_strided_threads_uint8_4, decompress_strided_threads_uint16_4, decompress_strided_threads_int16_4, decompress_strided_threads_float_as_double_4, decompress_strided_threads_double_as_float_4 }}},
+#else
+    {{{ NULL }}},
+#endif
+  };
+  /* function table [scalar type] for interleaved components */
+  void (*ctable[11])(zfp_stream*, zfp_field*) = {
+    decompress_components_int32, decompress_components_int64, decompress_components_float, decompress_components_double, decompress_components_half, decompress_components_bfloat16, decompress_components_uint8, decompress_components_uint16, decompress_components_int16, decompress_components_float_as_double, decompress_components_double_as_float
   };
   uint exec = zfp->exec.policy;
   uint strided = zfp_field_stride(field, NULL);
   uint dims = zfp_field_dimensionality(field);
-  uint type = field->type;
-  void (*decompress)(zfp_stream*, zfp_field*);
+  int type = type_index(field->type, zfp_field_compressed_type(field));
+  zfp_bool parallel = (exec == zfp_exec_omp || exec == zfp_exec_threads);
+  void (*decompress)(zfp_stream*, zfp_field*) = NULL;
+  zfp_bool (*decompress_par)(zfp_stream*, zfp_field*) = NULL;
+
+  if (type < 0)
+    return 0;
+
+  /* parallel decompression requires fixed-size blocks or a chunk index */
+  if (parallel && zfp->minbits != zfp->maxbits && !zfp->chunk_index)
+    return 0;
+
+  /* return 0 if decompression mode is not supported; interleaved components are
+     decompressed serially */
+  if (zfp_field_components(field) > 1)
+    decompress = exec == zfp_exec_serial ? ctable[type] : NULL;
+  else if (parallel)
+    decompress_par = ptable[exec == zfp_exec_threads][strided][dims - 1][type];
+  else
+    decompress = ftable[exec][strided][dims - 1][type];
+  if (!decompress && !decompress_par)
+    return 0;
+
+  /* callback streams support only sequential serial decompression */
+  if (exec != zfp_exec_serial && stream_is_callback(zfp->stream))
+    return 0;
+
+  /* serial decompression ignores chunk index; parallel decompression reads it */
+  if (zfp->chunk_index)
+    switch (exec) {
+      case zfp_exec_serial:
+        if (!chunk_index_skip(zfp->stream, field_block_count(field)))
+          return 0;
+        break;
+      case zfp_exec_omp:
+      case zfp_exec_threads:
+        break;
+      default:
+        return 0;
+    }
+
+  /* decompress field and align bit stream on word boundary */
+  if (decompress)
+    decompress(zfp, field);
+  else if (!decompress_par(zfp, field))
+    return 0;
+  stream_align(zfp->stream);
+
+  return stream_size(zfp->stream);
+}
+
+zfp_slab_cursor*
+zfp_decompress_begin(zfp_stream* zfp, const zfp_field* field)
+{
+  zfp_slab_cursor* cursor = slab_cursor_open(zfp, field, zfp_false);
+  if (!cursor)
+    return NULL;
+
+  /* serial decompression ignores chunk index */
+  if (zfp->chunk_index && !chunk_index_skip(zfp->stream, field_block_count(field))) {
+    free(cursor);
+    return NULL;
+  }
+
+  return cursor;
+}
+
+size_t
+zfp_decompress_slab(zfp_slab_cursor* cursor, void* data, size_t planes)
+{
+  /* function table [strided][dimensionality][scalar type] */
+  void (*ftable[2][4][11])(zfp_stream*, zfp_field*) = {
+    {{ decompress_int32_1,         decompress_int64_1,         decompress_float_1,         decompress_double_1,         decompress_half_1,         decompress_bfloat16_1, decompress_uint8_1, decompress_uint16_1, decompress_int16_1, decompress_float_as_double_1, decompress_double_as_float_1 },
+     { decompress_strided_int32_2, decompress_strided_int64_2, decompress_strided_float_2, decompress_strided_double_2, decompress_strided_half_2, decompress_strided_bfloat16_2, decompress_strided_uint8_2, decompress_strided_uint16_2, decompress_strided_int16_2, decompress_strided_float_as_double_2, decompress_strided_double_as_float_2 },
+     { decompress_strided_int32_3, decompress_strided_int64_3, decompress_strided_float_3, decompress_strided_double_3, decompress_strided_half_3, decompress_strided_bfloat16_3, decompress_strided_uint8_3, decompress_strided_uint16_3, decompress_strided_int16_3, decompress_strided_float_as_double_3, decompress_strided_double_as_float_3 },
+     { decompress_strided_int32_4, decompress_strided_int64_4, decompress_strided_float_4, decompress_strided_double_4, decompress_strided_half_4, decompress_strided_bfloat16_4, decompress_strided_uint8_4, decompress_strided_uint16_4, decompress_strided_int16_4, decompress_strided_float_as_double_4, decompress_strided_double_as_float_4 }},
+    {{ decompress_strided_int32_1, decompress_strided_int64_1, decompress_strided_float_1, decompress_strided_double_1, decompress_strided_half_1, decompress_strided_bfloat16_1, decompress_strided_uint8_1, decompress_strided_uint16_1, decompress_strided_int16_1, decompress_strided_float_as_double_1, decompress_strided_double_as_float_1 },
+     { decompress_strided_int32_2, decompress_strided_int64_2, decompress_strided_float_2, decompress_strided_double_2, decompress_strided_half_2, decompress_strided_bfloat16_2, decompress_strided_uint8_2, decompress_strided_uint16_2, decompress_strided_int16_2, decompress_strided_float_as_double_2, decompress_strided_double_as_float_2 },
+     { decompress_strided_int32_3, decompress_strided_int64_3, decompress_strided_float_3, decompress_strided_double_3, decompress_strided_half_3, decompress_strided_bfloat16_3, decompress_strided_uint8_3, decompress_strided_uint16_3, decompress_strided_int16_3, decompress_strided_float_as_double_3, decompress_strided_double_as_float_3 },
+     { decompress_strided_int32_4, decompress_strided_int64_4, decompress_strided_float_4, decompress_strided_double_4, decompress_strided_half_4, decompress_strided_bfloat16_4, decompress_strided_uint8_4, decompress_strided_uint16_4, decompress_strided_int16_4, decompress_strided_float_as_double_4, decompress_strided_double_as_float_4 }},
+  };
+  /* function table [scalar type] for interleaved components */
+  void (*ctable[11])(zfp_stream*, zfp_field*) = {
+    decompress_components_int32, decompress_components_int64, decompress_components_float, decompress_components_double, decompress_components_half, decompress_components_bfloat16, decompress_components_uint8, decompress_components_uint16, decompress_components_int16, decompress_components_float_as_double, decompress_components_double_as_float
+  };
+  zfp_stream* zfp;
+  const zfp_field* field;
+  zfp_field slab;
+  size_t* n;
+  uint strided;
+  uint dims;
+  int type;
+
+  if (!cursor || cursor->compress)
+    return 0;
+  zfp = cursor->stream;
+  field = &cursor->field;
+
+  /* slab is field restricted to planes along its slowest varying dimension */
+  slab = *field;
+  slab.data = data;
+  dims = zfp_field_dimensionality(field);
+  n = field_plane_count(&slab);
+
+  /* blocks may not straddle slabs, so request whole blocks of planes */
+  if (!planes || planes % 4)
+    return 0;
+  planes = MIN(planes, *n - cursor->plane);
+  if (!planes)
+    return 0;
+  *n = planes;
+
+  /* decompress whole blocks of slab in same order as zfp_decompress */
+  strided = zfp_field_stride(field, NULL);
+  type = type_index(field->type, zfp_field_compressed_type(field));
+  if (zfp_field_components(field) > 1)
+    ctable[type](zfp, &slab);
+  else
+    ftable[strided][dims - 1][type](zfp, &slab);
+  cursor->plane += planes;
+
+  return planes;
+}
+
+size_t
+zfp_decompress_end(zfp_slab_cursor* cursor)
+{
+  zfp_stream* zfp;
+  zfp_bool complete;
+
+  if (!cursor || cursor->compress)
+    return 0;
+  zfp = cursor->stream;
+  complete = (cursor->plane == *field_plane_count(&cursor->field));
+  free(cursor);
+
+  /* all planes of field must have been decompressed */
+  if (!complete)
+    return 0;
+
+  /* align bit stream on word boundary */
+  stream_align(zfp->stream);
+
+  return stream_size(zfp->stream);
+}
+
+zfp_bool
+zfp_decompress_box(zfp_stream* zfp, const zfp_field* field, zfp_field* box, size_t x, size_t y, size_t z, size_t w)
+{
+  /* function table [scalar type] */
+  zfp_bool (*btable[11])(zfp_stream*, const zfp_field*, zfp_field*, const size_t*) = {
+    decompress_box_int32, decompress_box_int64, decompress_box_float, decompress_box_double, decompress_box_half, decompress_box_bfloat16, decompress_box_uint8, decompress_box_uint16, decompress_box_int16, decompress_box_float_as_double, decompress_box_double_as_float
+  };
+  int type = type_index(box->type, zfp_field_compressed_type(field));
+  size_t origin[4];
+
+  /* box values must be convertible from array's compressed type, and box
+     must agree with array on dimensionality */
+  if (type < 0 || zfp_field_dimensionality(box) != zfp_field_dimensionality(field))
+    return zfp_false;
+
+  /* interleaved components are not supported */
+  if (zfp_field_components(field) > 1 || zfp_field_components(box) > 1)
+    return zfp_false;
+
+  /* random access requires the whole stream to be held in memory */
+  if (stream_is_callback(zfp->stream))
+    return zfp_false;
+
+  origin[0] = x;
+  origin[1] = y;
+  origin[2] = z;
+  origin[3] = w;
+
+  return btable[type](zfp, field, box, origin);
+}
+
+zfp_bool
+zfp_stream_block_bounds(zfp_stream* zfp, const zfp_field* field, const size_t* offsets, double* bounds, double* min, double* max)
+{
+  zfp_type type = zfp_field_compressed_type(field);
+  uint dims = zfp_field_dimensionality(field);
+  size_t blocks = field_block_count(field);
+  zfp_bool reversible = is_reversible(zfp);
+  bitstream* s = zfp->stream;
+  size_t offset = stream_rtell(s);
+  double lo = 0, hi = 0;
+  size_t base, block;
+  uint ebits;
+  int ebias;
 
   switch (type) {
-    case zfp_type_int32:
-    case zfp_type_int64:
     case zfp_type_float:
+      ebits = 8;
+      ebias = 127;
+      break;
     case zfp_type_double:
+      ebits = 11;
+      ebias = 1023;
       break;
     default:
-      return 0;
+      return zfp_false;
+  }
+  if (!dims)
+    return zfp_false;
+
+  /* random access requires the whole stream to be held in memory */
+  if (stream_is_callback(s))
+    return zfp_false;
+
+  /* without block offsets, blocks must be stored at fixed rate */
+  if (!offsets) {
+    if (reversible || zfp->minbits != zfp->maxbits)
+      return zfp_false;
+    if (zfp->chunk_index && !chunk_index_skip(s, blocks))
+      return zfp_false;
+  }
+  base = stream_rtell(s);
+
+  for (block = 0; block < blocks; block++) {
+    double bound;
+    stream_rseek(s, offsets ? offsets[block] : base + block * zfp->maxbits);
+    if (!stream_read_bit(s))
+      /* all values were zero or, in lossy modes, fell below the precision
+         needed to meet the minimum exponent */
+      bound = reversible ? 0 : ldexp(1.0, zfp->minexp - 2 * ((int)dims + 1));
+    else if (!reversible || !stream_read_bit(s))
+      /* all values are smaller in magnitude than 2^emax */
+      bound = ldexp(1.0, (int)stream_read_bits(s, ebits) - ebias);
+    else {
+      /* block was stored without common exponent, so decode it */
+      stream_rseek(s, offsets[block]);
+      bound = block_magnitude(zfp, type, dims);
+    }
+    if (bounds)
+      bounds[block] = bound;
+    lo = block ? MIN(lo, bound) : bound;
+    hi = MAX(hi, bound);
   }
 
-  /* return 0 if decompression mode is not supported */
-  decompress = ftable[exec][strided][dims - 1][type - zfp_type_int32];
-  if (!decompress)
+  if (min)
+    *min = lo;
+  if (max)
+    *max = hi;
+  stream_rseek(s, offset);
+
+  return zfp_true;
+}
+
+size_t
+zfp_stream_scale(zfp_stream* dst, zfp_stream* src, const zfp_field* field, double a)
+{
+  zfp_type type = zfp_field_compressed_type(field);
+  uint dims = zfp_field_dimensionality(field);
+  size_t blocks = field_block_count(field);
+  zfp_bool success;
+
+  /* only lossy floating-point streams are supported */
+  if (!dims || is_reversible(src) || is_reversible(dst))
+    return 0;
+  if (type != zfp_type_float && type != zfp_type_double)
+    return 0;
+  /* reject infinite and NaN scale factors */
+  if (!(a - a == 0))
     return 0;
 
-  /* decompress field and align bit stream on word boundary */
-  decompress(zfp, field);
-  stream_align(zfp->stream);
+  /* output stream records all blocks as one chunk */
+  if (src->chunk_index && !chunk_index_skip(src->stream, blocks))
+    return 0;
+  if (dst->chunk_index) {
+    chunk_index_begin(dst->stream, 1);
+    chunk_index_append(dst->stream, 0);
+  }
 
-  return stream_size(zfp->stream);
+  /* re-encode scaled transform coefficients block by block */
+  if (type == zfp_type_float)
+    success = scale_stream_float(dst, src, dims, blocks, a);
+  else
+    success = scale_stream_double(dst, src, dims, blocks, a);
+  if (!success)
+    return 0;
+
+  /* align bit streams on word boundary */
+  stream_align(src->stream);
+  stream_flush(dst->stream);
+
+  return stream_size(dst->stream);
+}
+
+size_t
+zfp_stream_add(zfp_stream* dst, zfp_stream* src1, zfp_stream* src2, const zfp_field* field)
+{
+  zfp_type type = zfp_field_compressed_type(field);
+  uint dims = zfp_field_dimensionality(field);
+  size_t blocks = field_block_count(field);
+  zfp_bool success;
+
+  /* only lossy floating-point streams are supported */
+  if (!dims || is_reversible(src1) || is_reversible(src2) || is_reversible(dst))
+    return 0;
+  if (type != zfp_type_float && type != zfp_type_double)
+    return 0;
+
+  /* output stream records all blocks as one chunk */
+  if (src1->chunk_index && !chunk_index_skip(src1->stream, blocks))
+    return 0;
+  if (src2->chunk_index && !chunk_index_skip(src2->stream, blocks))
+    return 0;
+  if (dst->chunk_index) {
+    chunk_index_begin(dst->stream, 1);
+    chunk_index_append(dst->stream, 0);
+  }
+
+  /* re-encode sums of aligned transform coefficients block by block */
+  if (type == zfp_type_float)
+    success = add_streams_float(dst, src1, src2, dims, blocks);
+  else
+    success = add_streams_double(dst, src1, src2, dims, blocks);
+  if (!success)
+    return 0;
+
+  /* align bit streams on word boundary */
+  stream_align(src1->stream);
+  stream_align(src2->stream);
+  stream_flush(dst->stream);
+
+  return stream_size(dst->stream);
 }
 
 size_t
@@ -1180,6 +2275,11 @@ zfp_write_header(zfp_stream* zfp, const zfp_field* field, uint mask)
     stream_write_bits(zfp->stream, mode, size);
     bits += size;
   }
+  /* 1-bit chunk index flag */
+  if (mask & ZFP_HEADER_INDEX) {
+    stream_write_bit(zfp->stream, zfp->chunk_index);
+    bits += ZFP_INDEX_BITS;
+  }
 
   return bits;
 }
@@ -1213,5 +2313,9 @@ zfp_read_header(zfp_stream* zfp, zfp_field* field, uint mask)
     if (zfp_stream_set_mode(zfp, mode) == zfp_mode_null)
       return 0;
   }
+  if (mask & ZFP_HEADER_INDEX) {
+    zfp->chunk_index = stream_read_bit(zfp->stream);
+    bits += ZFP_INDEX_BITS;
+  }
   return bits;
 }
@@ -45,6 +45,229 @@ TEST_F(TEST_FIXTURE, when_constructorCalledWithCacheSize_then_minCacheSizeEnforc
   EXPECT_LE(cacheSize, arr.cache_size());
 }
 
+TEST_F(TEST_FIXTURE, given_concurrentCache_when_readFromThreads_then_valuesMatchDecompressedArray)
+{
+#if DIMS == 1
+  ZFP_ARRAY_TYPE arr(inputDataSideLen, ZFP_RATE_PARAM_BITS, inputDataArr);
+#elif DIMS == 2
+  ZFP_ARRAY_TYPE arr(inputDataSideLen, inputDataSideLen, ZFP_RATE_PARAM_BITS, inputDataArr);
+#elif DIMS == 3
+  ZFP_ARRAY_TYPE arr(inputDataSideLen, inputDataSideLen, inputDataSideLen, ZFP_RATE_PARAM_BITS, inputDataArr);
+#elif DIMS == 4
+  ZFP_ARRAY_TYPE arr(inputDataSideLen, inputDataSideLen, inputDataSideLen, inputDataSideLen, ZFP_RATE_PARAM_BITS, inputDataArr);
+#endif
+
+  EXPECT_FALSE(arr.cache_concurrent());
+  arr.set_cache_concurrent(true);
+  EXPECT_TRUE(arr.cache_concurrent());
+
+  size_t n = arr.size();
+  SCALAR* expected = new SCALAR[n];
+  arr.get(expected);
+  arr.clear_cache();
+
+  // visit elements in scattered order to provoke cache line evictions
+  long mismatches = 0;
+  #pragma omp parallel for reduction(+:mismatches)
+  for (long i = 0; i < (long)n; i++) {
+    size_t index = (size_t)i * 7919 % n;
+    if (arr[index] != expected[index])
+      mismatches++;
+  }
+  EXPECT_EQ(0, mismatches);
+
+  delete[] expected;
+}
+
+TEST_F(TEST_FIXTURE, given_setAssociativeCache_when_read_then_valuesMatchDecompressedArray)
+{
+#if DIMS == 1
+  ZFP_ARRAY_TYPE arr(inputDataSideLen, ZFP_RATE_PARAM_BITS, inputDataArr);
+#elif DIMS == 2
+  ZFP_ARRAY_TYPE arr(inputDataSideLen, inputDataSideLen, ZFP_RATE_PARAM_BITS, inputDataArr);
+#elif DIMS == 3
+  ZFP_ARRAY_TYPE arr(inputDataSideLen, inputDataSideLen, inputDataSideLen, ZFP_RATE_PARAM_BITS, inputDataArr);
+#elif DIMS == 4
+  ZFP_ARRAY_TYPE arr(inputDataSideLen, inputDataSideLen, inputDataSideLen, inputDataSideLen, ZFP_RATE_PARAM_BITS, inputDataArr);
+#endif
+
+  EXPECT_EQ(1u, arr.cache_associativity());
+
+  size_t n = arr.size();
+  SCALAR* expected = new SCALAR[n];
+  arr.get(expected);
+
+  zfp::cache_policy policies[] = { zfp::cache_lru, zfp::cache_clock };
+  for (int p = 0; p < 2; p++) {
+    arr.set_cache_associativity(3, policies[p]);
+    EXPECT_EQ(4u, arr.cache_associativity());
+    EXPECT_EQ(policies[p], arr.cache_replacement());
+    EXPECT_EQ(0.0, arr.cache_hit_ratio());
+
+    // stream through array so that sets fill and lines are evicted
+    long mismatches = 0;
+    for (size_t i = 0; i < n; i++)
+      if (arr[i] != expected[i])
+        mismatches++;
+    EXPECT_EQ(0, mismatches);
+
+    double ratio = arr.cache_hit_ratio();
+    EXPECT_LT(0.0, ratio);
+    EXPECT_GT(1.0, ratio);
+  }
+
+  delete[] expected;
+}
+
+TEST_F(TEST_FIXTURE, given_prefetchedArray_when_iterate_then_allAccessesHitInCache)
+{
+  size_t blockSideLen = (inputDataSideLen + 3) / 4;
+  size_t blocks = 1;
+  size_t blockSize = sizeof(SCALAR);
+  for (int d = 0; d < DIMS; d++) {
+    blocks *= blockSideLen;
+    blockSize *= 4;
+  }
+
+  // leave room for all blocks plus the one line that prefetching never fills
+#if DIMS == 1
+  ZFP_ARRAY_TYPE arr(inputDataSideLen, ZFP_RATE_PARAM_BITS, inputDataArr, (blocks + 1) * blockSize);
+  arr.clear_cache();
+  arr.prefetch(0, inputDataSideLen);
+#elif DIMS == 2
+  ZFP_ARRAY_TYPE arr(inputDataSideLen, inputDataSideLen, ZFP_RATE_PARAM_BITS, inputDataArr, (blocks + 1) * blockSize);
+  arr.clear_cache();
+  arr.prefetch(0, 0, inputDataSideLen, inputDataSideLen);
+#elif DIMS == 3
+  ZFP_ARRAY_TYPE arr(inputDataSideLen, inputDataSideLen, inputDataSideLen, ZFP_RATE_PARAM_BITS, inputDataArr, (blocks + 1) * blockSize);
+  arr.clear_cache();
+  arr.prefetch(0, 0, 0, inputDataSideLen, inputDataSideLen, inputDataSideLen);
+#elif DIMS == 4
+  ZFP_ARRAY_TYPE arr(inputDataSideLen, inputDataSideLen, inputDataSideLen, inputDataSideLen, ZFP_RATE_PARAM_BITS, inputDataArr, (blocks + 1) * blockSize);
+  arr.clear_cache();
+  arr.prefetch(0, 0, 0, 0, inputDataSideLen, inputDataSideLen, inputDataSideLen, inputDataSideLen);
+#endif
+
+  // counts were reset on construction; only prefetching should have missed
+  size_t n = 0;
+  for (ZFP_ARRAY_TYPE::const_iterator it = arr.cbegin(); it != arr.cend(); ++it, n++)
+    (void)SCALAR(*it);
+  EXPECT_EQ(arr.size(), n);
+  EXPECT_EQ(double(n) / double(n + blocks), arr.cache_hit_ratio());
+}
+
+TEST_F(TEST_FIXTURE, given_array_when_iteratorCreated_then_firstBatchIsPrefetched)
+{
+#if DIMS == 1
+  ZFP_ARRAY_TYPE arr(inputDataSideLen, ZFP_RATE_PARAM_BITS, inputDataArr);
+#elif DIMS == 2
+  ZFP_ARRAY_TYPE arr(inputDataSideLen, inputDataSideLen, ZFP_RATE_PARAM_BITS, inputDataArr);
+#elif DIMS == 3
+  ZFP_ARRAY_TYPE arr(inputDataSideLen, inputDataSideLen, inputDataSideLen, ZFP_RATE_PARAM_BITS, inputDataArr);
+#elif DIMS == 4
+  ZFP_ARRAY_TYPE arr(inputDataSideLen, inputDataSideLen, inputDataSideLen, inputDataSideLen, ZFP_RATE_PARAM_BITS, inputDataArr);
+#endif
+  arr.clear_cache();
+
+  // the first block is decompressed when the iterator is created
+  ZFP_ARRAY_TYPE::const_iterator it = arr.cbegin();
+  EXPECT_EQ(0.0, arr.cache_hit_ratio());
+  (void)SCALAR(*it);
+  EXPECT_LT(0.0, arr.cache_hit_ratio());
+}
+
+TEST_F(TEST_FIXTURE, given_dataset_when_setAndGetInBulk_then_matchesElementwiseAccess)
+{
+  size_t blockSideLen = (inputDataSideLen + 3) / 4;
+  size_t blocks = 1;
+  size_t blockSize = sizeof(SCALAR);
+  for (int d = 0; d < DIMS; d++) {
+    blocks *= blockSideLen;
+    blockSize *= 4;
+  }
+
+  // bulk set encodes blocks concurrently; elementwise writes are cached and
+  // each block is encoded once when the cache is flushed
+#if DIMS == 1
+  ZFP_ARRAY_TYPE arr(inputDataSideLen, ZFP_RATE_PARAM_BITS, inputDataArr);
+  ZFP_ARRAY_TYPE arr2(inputDataSideLen, ZFP_RATE_PARAM_BITS, 0, blocks * blockSize);
+#elif DIMS == 2
+  ZFP_ARRAY_TYPE arr(inputDataSideLen, inputDataSideLen, ZFP_RATE_PARAM_BITS, inputDataArr);
+  ZFP_ARRAY_TYPE arr2(inputDataSideLen, inputDataSideLen, ZFP_RATE_PARAM_BITS, 0, blocks * blockSize);
+#elif DIMS == 3
+  ZFP_ARRAY_TYPE arr(inputDataSideLen, inputDataSideLen, inputDataSideLen, ZFP_RATE_PARAM_BITS, inputDataArr);
+  ZFP_ARRAY_TYPE arr2(inputDataSideLen, inputDataSideLen, inputDataSideLen, ZFP_RATE_PARAM_BITS, 0, blocks * blockSize);
+#elif DIMS == 4
+  ZFP_ARRAY_TYPE arr(inputDataSideLen, inputDataSideLen, inputDataSideLen, inputDataSideLen, ZFP_RATE_PARAM_BITS, inputDataArr);
+  ZFP_ARRAY_TYPE arr2(inputDataSideLen, inputDataSideLen, inputDataSideLen, inputDataSideLen, ZFP_RATE_PARAM_BITS, 0, blocks * blockSize);
+#endif
+
+  size_t n = arr.size();
+  for (size_t i = 0; i < n; i++)
+    arr2[i] = inputDataArr[i];
+  arr2.flush_cache();
+  ASSERT_EQ(arr2.compressed_size(), arr.compressed_size());
+  EXPECT_EQ(0, std::memcmp(arr2.compressed_data(), arr.compressed_data(), arr.compressed_size()));
+
+  // bulk get decodes uncached blocks concurrently
+  SCALAR* decompressed = new SCALAR[n];
+  arr.get(decompressed);
+  long mismatches = 0;
+  for (size_t i = 0; i < n; i++)
+    if (decompressed[i] != arr2[i])
+      mismatches++;
+  EXPECT_EQ(0, mismatches);
+
+  delete[] decompressed;
+}
+
+TEST_F(TEST_FIXTURE, given_fixedRateCodec_when_codeBlocksFromThreads_then_matchesSerialCoding)
+{
+  size_t blockSize = 1;
+  for (int d = 0; d < DIMS; d++)
+    blockSize *= 4;
+  long blocks = (long)(inputDataTotalLen / blockSize);
+
+  ZFP_ARRAY_TYPE::codec_type codec;
+  codec.set_rate(ZFP_RATE_PARAM_BITS, true);
+  uint maxbits;
+  codec.params(0, &maxbits, 0, 0);
+  size_t words = blocks * maxbits / 64;
+  uint64* serial = new uint64[words]();
+  uint64* parallel = new uint64[words]();
+
+  // word-aligned blocks may be encoded concurrently by one codec
+  codec.open(serial, words * sizeof(uint64));
+  for (long b = 0; b < blocks; b++)
+    codec.encode_block(b * maxbits, 0, inputDataArr + b * blockSize);
+  codec.close();
+  codec.open(parallel, words * sizeof(uint64));
+  #pragma omp parallel for
+  for (long b = 0; b < blocks; b++)
+    codec.encode_block(b * maxbits, 0, inputDataArr + b * blockSize);
+  EXPECT_EQ(0, std::memcmp(serial, parallel, words * sizeof(uint64)));
+
+  // and decoded concurrently
+  SCALAR* decoded = new SCALAR[blocks * blockSize];
+  #pragma omp parallel for
+  for (long b = 0; b < blocks; b++)
+    codec.decode_block(b * maxbits, 0, decoded + b * blockSize);
+  SCALAR* block = new SCALAR[blockSize];
+  long mismatches = 0;
+  for (long b = 0; b < blocks; b++) {
+    codec.decode_block(b * maxbits, 0, block);
+    if (std::memcmp(block, decoded + b * blockSize, blockSize * sizeof(SCALAR)))
+      mismatches++;
+  }
+  EXPECT_EQ(0, mismatches);
+  codec.close();
+
+  delete[] block;
+  delete[] decoded;
+  delete[] parallel;
+  delete[] serial;
+}
+
 TEST_F(TEST_FIXTURE, when_setRate_then_compressionRateChanged)
 {
   double oldRate = ZFP_RATE_PARAM_BITS;
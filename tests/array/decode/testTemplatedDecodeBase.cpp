@@ -16,6 +16,7 @@ extern "C" {
 #define PZ 3
 #define PW 4
 #define DUMMY_VAL 99
+#define BLOCK_COUNT 3
 #define ASSERT_SCALAR_EQ(x, y) ASSERT_NEAR(x, y, 1e-32)
 
 void populateArray(SCALAR** dataArr)
@@ -552,3 +553,60 @@ TEST(TemplatedDecodeTests, given_TemplatedDecodePartialBlockStrided_resultsMatch
     free(data1);
     free(data2);
 }
+
+TEST(TemplatedDecodeTests, given_TemplatedDecodeBlocks_resultsMatchNonTemplatedPerBlock)
+{
+    SCALAR* dataArr = new SCALAR[BLOCK_COUNT * BLOCK_SIZE];
+    for (int i = 0; i < BLOCK_COUNT * BLOCK_SIZE; i++)
+    {
+#ifdef FL_PT_DATA
+        dataArr[i] = nextSignedRandFlPt();
+#else
+        dataArr[i] = nextSignedRandInt();
+#endif
+    }
+
+    zfp_field* field = zfp_field_1d(dataArr, ZFP_TYPE, BLOCK_COUNT * BLOCK_SIZE);
+
+    zfp_stream* stream;
+    setupStream(&field, &stream);
+    for (int i = 0; i < BLOCK_COUNT; i++)
+        ZFP_ENCODE_BLOCK_FUNC(stream, dataArr + i * BLOCK_SIZE);
+    zfp_stream_flush(stream);
+    zfp_stream_rewind(stream);
+
+    zfp_stream* tstream;
+    setupStream(&field, &tstream);
+    encode_blocks<SCALAR, DIMS>(tstream, dataArr, BLOCK_COUNT);
+    zfp_stream_flush(tstream);
+    zfp_stream_rewind(tstream);
+
+    SCALAR* data1 = new SCALAR[BLOCK_COUNT * BLOCK_SIZE];
+    size_t sz = 0;
+    size_t offsets[BLOCK_COUNT];
+    for (int i = 0; i < BLOCK_COUNT; i++)
+    {
+        offsets[i] = stream_rtell(zfp_stream_bit_stream(stream));
+        sz += ZFP_DECODE_BLOCK_FUNC(stream, data1 + i * BLOCK_SIZE);
+    }
+
+    SCALAR* data2 = new SCALAR[BLOCK_COUNT * BLOCK_SIZE];
+    size_t toffsets[BLOCK_COUNT];
+    size_t tsz = decode_blocks<SCALAR, DIMS>(tstream, data2, BLOCK_COUNT, toffsets);
+
+    ASSERT_TRUE(sz == tsz);
+    for (int i = 0; i < BLOCK_COUNT; i++)
+        ASSERT_TRUE(offsets[i] == toffsets[i]);
+    for (int i = 0; i < BLOCK_COUNT * BLOCK_SIZE; i++)
+        ASSERT_SCALAR_EQ(data1[i], data2[i]);
+
+    zfp_field_free(field);
+    stream_close(zfp_stream_bit_stream(stream));
+    stream_close(zfp_stream_bit_stream(tstream));
+    zfp_stream_close(stream);
+    zfp_stream_close(tstream);
+
+    delete[] dataArr;
+    delete[] data1;
+    delete[] data2;
+}
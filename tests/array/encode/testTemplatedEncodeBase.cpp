@@ -16,6 +16,7 @@ extern "C" {
 #define PZ 3
 #define PW 4
 #define DUMMY_VAL 99
+#define BLOCK_COUNT 3
 
 void populateArray(SCALAR** dataArr)
 {
@@ -300,3 +301,45 @@ TEST(TemplatedEncodeTests, given_TemplatedEncodePartialBlockStrided_resultsMatch
     delete[] dataArr;
 
 }
+
+TEST(TemplatedEncodeTests, given_TemplatedEncodeBlocks_resultsMatchNonTemplatedPerBlock)
+{
+    SCALAR* dataArr = new SCALAR[BLOCK_COUNT * BLOCK_SIZE];
+    for (int i = 0; i < BLOCK_COUNT * BLOCK_SIZE; i++)
+    {
+#ifdef FL_PT_DATA
+        dataArr[i] = nextSignedRandFlPt();
+#else
+        dataArr[i] = nextSignedRandInt();
+#endif
+    }
+
+    zfp_field* field = zfp_field_1d(dataArr, ZFP_TYPE, BLOCK_COUNT * BLOCK_SIZE);
+
+    zfp_stream* stream;
+    setupStream(&field, &stream);
+    size_t sz = 0;
+    size_t offsets[BLOCK_COUNT];
+    for (int i = 0; i < BLOCK_COUNT; i++)
+    {
+        offsets[i] = stream_wtell(zfp_stream_bit_stream(stream));
+        sz += ZFP_ENCODE_BLOCK_FUNC(stream, dataArr + i * BLOCK_SIZE);
+    }
+
+    zfp_stream* tstream;
+    setupStream(&field, &tstream);
+    size_t toffsets[BLOCK_COUNT];
+    size_t tsz = encode_blocks<SCALAR, DIMS>(tstream, dataArr, BLOCK_COUNT, toffsets);
+
+    ASSERT_TRUE(sz == tsz);
+    for (int i = 0; i < BLOCK_COUNT; i++)
+        ASSERT_TRUE(offsets[i] == toffsets[i]);
+    ASSERT_TRUE(streamsEqual(&stream, &tstream));
+
+    zfp_field_free(field);
+    stream_close(zfp_stream_bit_stream(stream));
+    stream_close(zfp_stream_bit_stream(tstream));
+    zfp_stream_close(stream);
+    zfp_stream_close(tstream);
+    delete[] dataArr;
+}
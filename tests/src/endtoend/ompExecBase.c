@@ -88,7 +88,7 @@ setThreadCount(struct setupVars *bundle, int param)
 }
 
 // OpenMP endtoend entry functions
-// pass doDecompress=0 because decompression not yet supported
+// decompression is supported only in fixed-rate mode or with a chunk index
 // loop across 3 compression parameters
 
 // returns 0 on success, 1 on test failure
@@ -121,7 +121,8 @@ runCompressAcrossThreadsChunks(void **state, zfp_mode mode)
       }
 
       int numCompressParams = (mode == zfp_mode_reversible) ? 1 : 3;
-      failures += runCompressDecompressAcrossParamsGivenMode(state, 0, mode, numCompressParams);
+      int doDecompress = (mode == zfp_mode_fixed_rate);
+      failures += runCompressDecompressAcrossParamsGivenMode(state, doDecompress, mode, numCompressParams);
     }
   }
 
@@ -132,6 +133,66 @@ runCompressAcrossThreadsChunks(void **state, zfp_mode mode)
   return failures > 0;
 }
 
+// chunk index alters compressed bitstream, so only decompressed arrays are checked
+// returns 0 on success, 1 on test failure
+static int
+runChunkIndexAcrossThreadsChunks(void **state, zfp_mode mode)
+{
+  struct setupVars *bundle = *state;
+  zfp_stream* stream = bundle->stream;
+
+  int failures = 0;
+  int threadParam, chunkParam, compressParam;
+  zfp_stream_set_chunk_index(stream, zfp_true);
+
+  // run across 3 thread counts
+  for (threadParam = 0; threadParam < 3; threadParam++) {
+    uint threadCount = setThreadCount(bundle, threadParam);
+    if (threadCount == 0) {
+      printf("Threadcount was 0\n");
+      failures += 3;
+      continue;
+    } else {
+      printf("\t\tThread count: %u\n", threadCount);
+    }
+
+    for (chunkParam = 0; chunkParam < 3; chunkParam++) {
+      uint chunkSize = setChunkSize(state, threadCount, chunkParam);
+      if (chunkSize == 0) {
+        printf("ERROR: Computed chunk size was 0 blocks\n");
+        failures++;
+        continue;
+      } else {
+        printf("\t\t\tChunk size: %u blocks\n", chunkSize);
+      }
+
+      for (compressParam = 0; compressParam < 3; compressParam++) {
+        size_t compressedBytes;
+        if (setupCompressParam(bundle, mode, compressParam) == 1 ||
+            runZfpCompress(stream, bundle->field, bundle->timer, &compressedBytes) == 1) {
+          failures++;
+          continue;
+        }
+
+        zfp_stream_rewind(stream);
+        if (runZfpDecompress(stream, bundle->decompressField, bundle->timer, compressedBytes) == 1 ||
+            isDecompressedArrayChecksumsMatch(bundle) == 1) {
+          failures++;
+        }
+
+        zfp_stream_rewind(stream);
+        memset(bundle->buffer, 0, bundle->bufsizeBytes);
+      }
+    }
+  }
+
+  if (failures > 0) {
+    fail_msg("Overall chunk index compress/decompress test failure\n");
+  }
+
+  return failures > 0;
+}
+
 static void
 _catFunc3(given_, DESCRIPTOR, Array_when_ZfpCompressFixedPrecision_expect_BitstreamChecksumsMatch)(void **state)
 {
@@ -158,6 +219,83 @@ _catFunc3(given_, DESCRIPTOR, Array_when_ZfpCompressReversible_expect_BitstreamC
   runCompressAcrossThreadsChunks(state, zfp_mode_reversible);
 }
 
+static void
+_catFunc3(given_, DESCRIPTOR, Array_when_ZfpDecompressFixedPrecisionWithChunkIndex_expect_ArrayChecksumsMatch)(void **state)
+{
+  runChunkIndexAcrossThreadsChunks(state, zfp_mode_fixed_precision);
+}
+
+#ifdef FL_PT_DATA
+static void
+_catFunc3(given_, DESCRIPTOR, Array_when_ZfpDecompressFixedAccuracyWithChunkIndex_expect_ArrayChecksumsMatch)(void **state)
+{
+  runChunkIndexAcrossThreadsChunks(state, zfp_mode_fixed_accuracy);
+}
+#endif
+
+static void
+_catFunc3(given_, DESCRIPTOR, Array_when_ZfpDecompressCorruptChunkIndex_expect_Failure)(void **state)
+{
+  struct setupVars *bundle = *state;
+  zfp_stream* stream = bundle->stream;
+  uint64* index = (uint64*)bundle->buffer;
+  size_t compressedBytes;
+  zfp_stream_set_chunk_index(stream, zfp_true);
+
+  uint threadCount = setThreadCount(bundle, 2);
+  if (threadCount == 0 ||
+      setChunkSize(state, threadCount, 1) == 0 ||
+      setupCompressParam(bundle, zfp_mode_fixed_precision, 1) == 1 ||
+      runZfpCompress(stream, bundle->field, bundle->timer, &compressedBytes) == 1) {
+    fail_msg("Chunk index compression failure\n");
+  }
+
+  // point last chunk past end of stream
+  index[index[0]] = ~(uint64)0;
+
+  zfp_stream_rewind(stream);
+  assert_int_equal(zfp_decompress(stream, bundle->decompressField), 0);
+}
+
+static size_t
+discardSink(const void* data, size_t bytes, void* context)
+{
+  return bytes;
+}
+
+static size_t
+emptySource(void* data, size_t bytes, void* context)
+{
+  return 0;
+}
+
+static void
+_catFunc3(given_, DESCRIPTOR, Array_when_ZfpCompressOrDecompressCallbackStream_expect_Failure)(void **state)
+{
+  struct setupVars *bundle = *state;
+  zfp_stream* stream = bundle->stream;
+  bitstream* memoryStream = zfp_stream_bit_stream(stream);
+  uint64 buffer[8];
+
+  uint threadCount = setThreadCount(bundle, 2);
+  if (threadCount == 0 ||
+      setChunkSize(state, threadCount, 1) == 0 ||
+      setupCompressParam(bundle, zfp_mode_fixed_rate, 1) == 1) {
+    fail_msg("Callback stream setup failure\n");
+  }
+
+  // callback streams do not support the random access that threads need
+  zfp_stream_set_bit_stream(stream, stream_open_sink(buffer, sizeof(buffer), discardSink, NULL));
+  assert_int_equal(zfp_compress(stream, bundle->field), 0);
+  stream_close(zfp_stream_bit_stream(stream));
+
+  zfp_stream_set_bit_stream(stream, stream_open_source(buffer, sizeof(buffer), emptySource, NULL));
+  assert_int_equal(zfp_decompress(stream, bundle->decompressField), 0);
+  stream_close(zfp_stream_bit_stream(stream));
+
+  zfp_stream_set_bit_stream(stream, memoryStream);
+}
+
 static void
 _catFunc3(given_, DESCRIPTOR, ReversedArray_when_ZfpCompressFixedPrecision_expect_BitstreamChecksumsMatch)(void **state)
 {
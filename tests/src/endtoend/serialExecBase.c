@@ -273,6 +273,761 @@ _catFunc3(given_, DESCRIPTOR, Array_when_ZfpCompressFixedAccuracy_expect_Compres
 // #endif FL_PT_DATA
 #endif
 
+// returns 0 on success, 1 on test failure
+static int
+isDecompressedBoxMatchingDecompressedArray(struct setupVars* bundle)
+{
+  zfp_field* field = bundle->field;
+  zfp_stream* stream = bundle->stream;
+  size_t* n = bundle->randomGenArrSideLen;
+
+  size_t compressedBytes = zfp_compress(stream, field);
+  if (compressedBytes == 0) {
+    printf("Compression failed\n");
+    return 1;
+  }
+
+  zfp_stream_rewind(stream);
+  if (zfp_decompress(stream, bundle->decompressField) != compressedBytes) {
+    printf("Decompression failed\n");
+    return 1;
+  }
+
+  // box starting one third into array, spanning one third plus one value
+  size_t origin[4] = {0, 0, 0, 0};
+  size_t extent[4] = {1, 1, 1, 1};
+  size_t boxLen = 1;
+  int i;
+  for (i = 0; i < DIMS; i++) {
+    origin[i] = n[i] / 3;
+    extent[i] = n[i] / 3 + 1;
+    boxLen *= extent[i];
+  }
+
+  Scalar* boxArr = calloc(boxLen, sizeof(Scalar));
+  assert_non_null(boxArr);
+  zfp_field* box = zfp_field_alloc();
+  zfp_field_set_pointer(box, boxArr);
+  zfp_field_set_type(box, ZFP_TYPE);
+  switch (DIMS) {
+    case 1:
+      zfp_field_set_size_1d(box, extent[0]);
+      break;
+    case 2:
+      zfp_field_set_size_2d(box, extent[0], extent[1]);
+      break;
+    case 3:
+      zfp_field_set_size_3d(box, extent[0], extent[1], extent[2]);
+      break;
+    case 4:
+      zfp_field_set_size_4d(box, extent[0], extent[1], extent[2], extent[3]);
+      break;
+  }
+
+  int failures = 0;
+  zfp_stream_rewind(stream);
+  if (!zfp_decompress_box(stream, field, box, origin[0], origin[1], origin[2], origin[3])) {
+    printf("Box decompression failed\n");
+    failures++;
+  } else {
+    // box values must match those of entire decompressed array
+    size_t nx = n[0];
+    size_t ny = n[1] ? n[1] : 1;
+    size_t nz = n[2] ? n[2] : 1;
+    size_t x, y, z, w;
+    Scalar* p = boxArr;
+    for (w = 0; w < extent[3]; w++)
+      for (z = 0; z < extent[2]; z++)
+        for (y = 0; y < extent[1]; y++)
+          for (x = 0; x < extent[0]; x++, p++) {
+            size_t offset = (origin[0] + x) + nx * ((origin[1] + y) + ny * ((origin[2] + z) + nz * (origin[3] + w)));
+            if (memcmp(p, &bundle->decompressedArr[offset], sizeof(Scalar))) {
+              printf("Box value at (%zu, %zu, %zu, %zu) differs from decompressed array\n", x, y, z, w);
+              failures++;
+            }
+          }
+  }
+
+  zfp_field_free(box);
+  free(boxArr);
+
+  return failures > 0;
+}
+
+static void
+runDecompressBoxTests(void **state, zfp_mode mode)
+{
+  struct setupVars *bundle = *state;
+
+  int failures = 0;
+  int compressParam;
+  for (compressParam = 0; compressParam < 3; compressParam++) {
+    if (setupCompressParam(bundle, mode, compressParam) == 1) {
+      failures++;
+      continue;
+    }
+
+    failures += isDecompressedBoxMatchingDecompressedArray(bundle);
+
+    zfp_stream_rewind(bundle->stream);
+    memset(bundle->buffer, 0, bundle->bufsizeBytes);
+  }
+
+  if (failures > 0) {
+    fail_msg("Box decompression test failure\n");
+  }
+}
+
+static void
+_catFunc3(given_, DESCRIPTOR, Array_when_ZfpDecompressBoxFixedRate_expect_BoxMatchesDecompressedArray)(void **state)
+{
+  runDecompressBoxTests(state, zfp_mode_fixed_rate);
+}
+
+static void
+_catFunc3(given_, DESCRIPTOR, Array_when_ZfpDecompressBoxFixedPrecision_expect_BoxMatchesDecompressedArray)(void **state)
+{
+  runDecompressBoxTests(state, zfp_mode_fixed_precision);
+}
+
+static void
+_catFunc3(given_, DESCRIPTOR, Array_when_ZfpDecompressCorruptChunkCount_expect_Failure)(void **state)
+{
+  struct setupVars *bundle = *state;
+  zfp_stream* stream = bundle->stream;
+  uint64* index = (uint64*)bundle->buffer;
+  zfp_stream_set_chunk_index(stream, zfp_true);
+
+  if (setupCompressParam(bundle, zfp_mode_fixed_precision, 1) == 1)
+    fail_msg("ERROR while setting zfp mode");
+  zfp_stream_rewind(stream);
+  if (zfp_compress(stream, bundle->field) == 0)
+    fail_msg("Chunk index compression failure");
+
+  // claim more chunks than there are blocks
+  index[0] = ~(uint64)0;
+
+  zfp_stream_rewind(stream);
+  assert_int_equal(zfp_decompress(stream, bundle->decompressField), 0);
+  zfp_stream_rewind(stream);
+  assert_null(zfp_decompress_begin(stream, bundle->decompressField));
+}
+
+static void
+_catFunc3(given_, DESCRIPTOR, Array_when_ZfpDecompressBoxCorruptChunkIndex_expect_Failure)(void **state)
+{
+  struct setupVars *bundle = *state;
+  zfp_stream* stream = bundle->stream;
+  uint64* index = (uint64*)bundle->buffer;
+  zfp_stream_set_chunk_index(stream, zfp_true);
+
+  if (setupCompressParam(bundle, zfp_mode_fixed_precision, 1) == 1)
+    fail_msg("ERROR while setting zfp mode");
+  zfp_stream_rewind(stream);
+  if (zfp_compress(stream, bundle->field) == 0)
+    fail_msg("Chunk index compression failure");
+
+  // point only chunk past end of stream
+  index[1] = ~(uint64)0;
+
+  zfp_stream_rewind(stream);
+  assert_int_equal(zfp_decompress_box(stream, bundle->field, bundle->decompressField, 0, 0, 0, 0), zfp_false);
+  assert_int_equal(stream_rtell(zfp_stream_bit_stream(stream)), 0);
+}
+
+static size_t
+emptySource(void* data, size_t bytes, void* context)
+{
+  return 0;
+}
+
+static void
+_catFunc3(given_, DESCRIPTOR, SourceStream_when_ZfpDecompressBox_expect_Failure)(void **state)
+{
+  struct setupVars *bundle = *state;
+  zfp_stream* stream = bundle->stream;
+  bitstream* memoryStream = zfp_stream_bit_stream(stream);
+  uint64 buffer[8];
+
+  if (setupCompressParam(bundle, zfp_mode_fixed_rate, 1) == 1)
+    fail_msg("ERROR while setting zfp mode");
+
+  // box decompression seeks backward, which source streams do not support
+  zfp_stream_set_bit_stream(stream, stream_open_source(buffer, sizeof(buffer), emptySource, NULL));
+  assert_int_equal(zfp_decompress_box(stream, bundle->field, bundle->decompressField, 0, 0, 0, 0), zfp_false);
+  stream_close(zfp_stream_bit_stream(stream));
+
+  zfp_stream_set_bit_stream(stream, memoryStream);
+}
+
+// memory standing in for file written through sink callback
+struct sinkFile {
+  unsigned char* data;
+  size_t size;
+  size_t capacity;
+};
+
+static size_t
+sinkToFile(const void* data, size_t bytes, void* context)
+{
+  struct sinkFile* f = (struct sinkFile*)context;
+  if (bytes > f->capacity - f->size)
+    bytes = f->capacity - f->size;
+  memcpy(f->data + f->size, data, bytes);
+  f->size += bytes;
+  return bytes;
+}
+
+// returns 0 on success, 1 on test failure; when toSink is set, slabs are
+// compressed through a sink stream whose buffer holds only a few words
+static int
+isSlabCompressedStreamMatchingCompressedStream(struct setupVars* bundle, int toSink)
+{
+  zfp_field* field = bundle->field;
+  zfp_stream* stream = bundle->stream;
+  bitstream* memoryStream = zfp_stream_bit_stream(stream);
+  uint64 sinkBuffer[8];
+  struct sinkFile f;
+
+  size_t compressedBytes = zfp_compress(stream, field);
+  if (compressedBytes == 0) {
+    printf("Compression failed\n");
+    return 1;
+  }
+
+  unsigned char* expected = malloc(compressedBytes);
+  assert_non_null(expected);
+  memcpy(expected, bundle->buffer, compressedBytes);
+  memset(bundle->buffer, 0, bundle->bufsizeBytes);
+
+  // supply slowest varying dimension in slabs of 4 and 8 planes
+  ptrdiff_t s[4];
+  zfp_field_stride(field, s);
+  size_t n = bundle->randomGenArrSideLen[DIMS - 1];
+  size_t plane = 0;
+  size_t planes = 4;
+  int failures = 0;
+
+  zfp_stream_rewind(stream);
+  if (toSink) {
+    f.data = (unsigned char*)bundle->buffer;
+    f.size = 0;
+    f.capacity = bundle->bufsizeBytes;
+    zfp_stream_set_bit_stream(stream, stream_open_sink(sinkBuffer, sizeof(sinkBuffer), sinkToFile, &f));
+  }
+  zfp_slab_cursor* cursor = zfp_compress_begin(stream, field);
+  if (!cursor) {
+    printf("Slab compression could not begin\n");
+    failures++;
+  } else {
+    while (plane < n) {
+      planes = 12 - planes;
+      if (planes > n - plane)
+        planes = n - plane;
+      const Scalar* p = (const Scalar*)field->data + s[DIMS - 1] * (ptrdiff_t)plane;
+      if (!zfp_compress_slab(cursor, p, planes)) {
+        printf("Slab compression failed at plane %zu\n", plane);
+        failures++;
+        break;
+      }
+      plane += planes;
+    }
+
+    size_t slabBytes = zfp_compress_end(cursor);
+    if (!failures && slabBytes != compressedBytes) {
+      printf("Slab compressed size %zu differs from %zu\n", slabBytes, compressedBytes);
+      failures++;
+    } else if (!failures && memcmp(bundle->buffer, expected, compressedBytes)) {
+      printf("Slab compressed stream differs from compressed stream\n");
+      failures++;
+    }
+  }
+
+  if (toSink) {
+    if (!failures && f.size != compressedBytes) {
+      printf("Sink received %zu bytes instead of %zu\n", f.size, compressedBytes);
+      failures++;
+    }
+    stream_close(zfp_stream_bit_stream(stream));
+    zfp_stream_set_bit_stream(stream, memoryStream);
+  }
+
+  free(expected);
+
+  return failures > 0;
+}
+
+static void
+runCompressSlabTests(void **state, zfp_mode mode, int toSink)
+{
+  struct setupVars *bundle = *state;
+
+  int failures = 0;
+  int compressParam;
+  for (compressParam = 0; compressParam < 3; compressParam++) {
+    if (setupCompressParam(bundle, mode, compressParam) == 1) {
+      failures++;
+      continue;
+    }
+
+    failures += isSlabCompressedStreamMatchingCompressedStream(bundle, toSink);
+
+    zfp_stream_rewind(bundle->stream);
+    memset(bundle->buffer, 0, bundle->bufsizeBytes);
+  }
+
+  if (failures > 0) {
+    fail_msg("Slab compression test failure\n");
+  }
+}
+
+static void
+_catFunc3(given_, DESCRIPTOR, Array_when_ZfpCompressSlabFixedRate_expect_StreamMatchesZfpCompress)(void **state)
+{
+  runCompressSlabTests(state, zfp_mode_fixed_rate, 0);
+}
+
+static void
+_catFunc3(given_, DESCRIPTOR, Array_when_ZfpCompressSlabFixedPrecision_expect_StreamMatchesZfpCompress)(void **state)
+{
+  runCompressSlabTests(state, zfp_mode_fixed_precision, 0);
+}
+
+static void
+_catFunc3(given_, DESCRIPTOR, Array_when_ZfpCompressSlabToSinkStream_expect_SinkReceivesZfpCompressStream)(void **state)
+{
+  runCompressSlabTests(state, zfp_mode_fixed_precision, 1);
+}
+
+// returns 0 on success, 1 on test failure
+static int
+isSlabDecompressedArrayMatchingDecompressedArray(struct setupVars* bundle)
+{
+  zfp_field* field = bundle->field;
+  zfp_stream* stream = bundle->stream;
+  size_t* n = bundle->randomGenArrSideLen;
+
+  size_t compressedBytes = zfp_compress(stream, field);
+  if (compressedBytes == 0) {
+    printf("Compression failed\n");
+    return 1;
+  }
+
+  zfp_stream_rewind(stream);
+  if (zfp_decompress(stream, bundle->decompressField) != compressedBytes) {
+    printf("Decompression failed\n");
+    return 1;
+  }
+
+  // buffer holding one slab of 4 planes along slowest varying dimension
+  size_t planeLen = 1;
+  int i;
+  for (i = 0; i < DIMS - 1; i++)
+    planeLen *= n[i];
+  Scalar* slabArr = calloc(4 * planeLen, sizeof(Scalar));
+  assert_non_null(slabArr);
+
+  // cursor holds its own copy of the field metadata
+  zfp_field slabField = *field;
+  int failures = 0;
+  zfp_stream_rewind(stream);
+  zfp_slab_cursor* cursor = zfp_decompress_begin(stream, &slabField);
+  memset(&slabField, 0, sizeof(slabField));
+  if (!cursor) {
+    printf("Slab decompression could not begin\n");
+    failures++;
+  } else {
+    // decompression cursor cannot be used for compression
+    if (zfp_compress_slab(cursor, slabArr, 4)) {
+      printf("Slab compression accepted decompression cursor\n");
+      failures++;
+    }
+
+    // slab values must match those of entire decompressed array
+    size_t plane = 0;
+    size_t planes;
+    while ((planes = zfp_decompress_slab(cursor, slabArr, 4)) != 0) {
+      if (memcmp(slabArr, &bundle->decompressedArr[plane * planeLen], planes * planeLen * sizeof(Scalar))) {
+        printf("Slab at plane %zu differs from decompressed array\n", plane);
+        failures++;
+      }
+      plane += planes;
+    }
+
+    if (plane != n[DIMS - 1]) {
+      printf("Slab decompression ended at plane %zu of %zu\n", plane, n[DIMS - 1]);
+      failures++;
+    }
+    if (zfp_decompress_end(cursor) != compressedBytes) {
+      printf("Slab decompression consumed wrong number of bytes\n");
+      failures++;
+    }
+  }
+
+  free(slabArr);
+
+  return failures > 0;
+}
+
+static void
+runDecompressSlabTests(void **state, zfp_mode mode)
+{
+  struct setupVars *bundle = *state;
+
+  int failures = 0;
+  int compressParam;
+  for (compressParam = 0; compressParam < 3; compressParam++) {
+    if (setupCompressParam(bundle, mode, compressParam) == 1) {
+      failures++;
+      continue;
+    }
+
+    failures += isSlabDecompressedArrayMatchingDecompressedArray(bundle);
+
+    zfp_stream_rewind(bundle->stream);
+    memset(bundle->buffer, 0, bundle->bufsizeBytes);
+  }
+
+  if (failures > 0) {
+    fail_msg("Slab decompression test failure\n");
+  }
+}
+
+static void
+_catFunc3(given_, DESCRIPTOR, Array_when_ZfpDecompressSlabFixedRate_expect_SlabsMatchDecompressedArray)(void **state)
+{
+  runDecompressSlabTests(state, zfp_mode_fixed_rate);
+}
+
+static void
+_catFunc3(given_, DESCRIPTOR, Array_when_ZfpDecompressSlabFixedPrecision_expect_SlabsMatchDecompressedArray)(void **state)
+{
+  runDecompressSlabTests(state, zfp_mode_fixed_precision);
+}
+
+// returns 0 on success, 1 on test failure
+static int
+isEstimatedSizeMatchingCompressedSize(struct setupVars* bundle, zfp_mode mode)
+{
+  zfp_field* field = bundle->field;
+  zfp_stream* stream = bundle->stream;
+
+  size_t compressedBytes = zfp_compress(stream, field);
+  if (compressedBytes == 0) {
+    printf("Compression failed\n");
+    return 1;
+  }
+
+  int failures = 0;
+
+  // sampling every block yields the exact compressed size
+  size_t bound;
+  size_t estimate = zfp_stream_estimate_size(stream, field, 1.0, &bound);
+  if (estimate != compressedBytes || bound != compressedBytes) {
+    printf("Estimated size %zu (bound %zu) differs from compressed size %zu\n", estimate, bound, compressedBytes);
+    failures++;
+  }
+
+  // in fixed-rate mode, any sample yields the exact compressed size
+  estimate = zfp_stream_estimate_size(stream, field, 0.1, &bound);
+  if (mode == zfp_mode_fixed_rate && (estimate != compressedBytes || bound != compressedBytes)) {
+    printf("Sampled fixed-rate size %zu differs from compressed size %zu\n", estimate, compressedBytes);
+    failures++;
+  }
+  else if (estimate == 0 || bound < estimate || bound > zfp_stream_maximum_size(stream, field)) {
+    printf("Sampled size %zu has invalid bound %zu\n", estimate, bound);
+    failures++;
+  }
+
+  if (zfp_stream_estimate_size(stream, field, 0.0, NULL) != 0) {
+    printf("Estimate with empty sample did not fail\n");
+    failures++;
+  }
+
+  return failures > 0;
+}
+
+static void
+runEstimateSizeTests(void **state, zfp_mode mode)
+{
+  struct setupVars *bundle = *state;
+
+  int failures = 0;
+  int compressParam;
+  for (compressParam = 0; compressParam < 3; compressParam++) {
+    if (setupCompressParam(bundle, mode, compressParam) == 1) {
+      failures++;
+      continue;
+    }
+
+    failures += isEstimatedSizeMatchingCompressedSize(bundle, mode);
+
+    zfp_stream_rewind(bundle->stream);
+    memset(bundle->buffer, 0, bundle->bufsizeBytes);
+  }
+
+  if (failures > 0) {
+    fail_msg("Size estimation test failure\n");
+  }
+}
+
+static void
+_catFunc3(given_, DESCRIPTOR, Array_when_ZfpStreamEstimateSizeFixedRate_expect_EstimateMatchesCompressedSize)(void **state)
+{
+  runEstimateSizeTests(state, zfp_mode_fixed_rate);
+}
+
+static void
+_catFunc3(given_, DESCRIPTOR, Array_when_ZfpStreamEstimateSizeFixedPrecision_expect_EstimateMatchesCompressedSize)(void **state)
+{
+  runEstimateSizeTests(state, zfp_mode_fixed_precision);
+}
+
+// returns 0 on success, 1 on test failure
+static int
+isBlockBoundsBoundingBlockValues(struct setupVars* bundle, zfp_mode mode)
+{
+  zfp_field* field = bundle->field;
+  zfp_stream* stream = bundle->stream;
+  const Scalar* data = (const Scalar*)field->data;
+  size_t n[4] = { field->nx, field->ny ? field->ny : 1, field->nz ? field->nz : 1, field->nw ? field->nw : 1 };
+  size_t m[4] = { (n[0] + 3) / 4, (n[1] + 3) / 4, (n[2] + 3) / 4, (n[3] + 3) / 4 };
+  size_t blocks = m[0] * m[1] * m[2] * m[3];
+  ptrdiff_t s[4] = { 0, 0, 0, 0 };
+  zfp_field_stride(field, s);
+
+  size_t compressedBytes = zfp_compress(stream, field);
+  zfp_stream_rewind(stream);
+  if (compressedBytes == 0) {
+    printf("Compression failed\n");
+    return 1;
+  }
+
+  // variable-rate streams require bit offsets of blocks
+  size_t* offsets = NULL;
+  if (mode != zfp_mode_fixed_rate) {
+    Scalar* blockArr = malloc(blocks * BLOCK_SIZE * sizeof(Scalar));
+    offsets = malloc(blocks * sizeof(size_t));
+    assert_non_null(blockArr);
+    assert_non_null(offsets);
+    _t2(zfp_decode_blocks, Scalar, DIMS)(stream, blockArr, blocks, offsets);
+    zfp_stream_rewind(stream);
+    free(blockArr);
+  }
+
+  int failures = 0;
+  double* bounds = malloc(blocks * sizeof(double));
+  assert_non_null(bounds);
+  double min, max;
+  zfp_bool status = zfp_stream_block_bounds(stream, field, offsets, bounds, &min, &max);
+  if (stream_rtell(zfp_stream_bit_stream(stream)) != 0) {
+    printf("Stream was not left at first block\n");
+    failures++;
+  }
+
+#ifdef FL_PT_DATA
+  if (!status) {
+    printf("Block bounds query failed\n");
+    failures++;
+  }
+  else {
+    // each bound exceeds block values by at most a factor of two
+    double lo = bounds[0], hi = bounds[0];
+    size_t b = 0;
+    size_t bx, by, bz, bw, x, y, z, w;
+    for (bw = 0; bw < m[3]; bw++)
+      for (bz = 0; bz < m[2]; bz++)
+        for (by = 0; by < m[1]; by++)
+          for (bx = 0; bx < m[0]; bx++, b++) {
+            double vmax = 0;
+            for (w = 4 * bw; w < n[3] && w < 4 * bw + 4; w++)
+              for (z = 4 * bz; z < n[2] && z < 4 * bz + 4; z++)
+                for (y = 4 * by; y < n[1] && y < 4 * by + 4; y++)
+                  for (x = 4 * bx; x < n[0] && x < 4 * bx + 4; x++) {
+                    double v = fabs((double)data[x * s[0] + y * s[1] + z * s[2] + w * s[3]]);
+                    if (vmax < v)
+                      vmax = v;
+                  }
+            if (vmax > bounds[b] || bounds[b] > 2 * vmax) {
+              printf("Block %zu bound %g does not bound block maximum %g\n", b, bounds[b], vmax);
+              failures++;
+              break;
+            }
+            if (lo > bounds[b])
+              lo = bounds[b];
+            if (hi < bounds[b])
+              hi = bounds[b];
+          }
+    if (min != lo || max != hi) {
+      printf("Bound range [%g, %g] differs from expected [%g, %g]\n", min, max, lo, hi);
+      failures++;
+    }
+  }
+#else
+  // integer blocks carry no exponent
+  if (status) {
+    printf("Block bounds query on integer stream did not fail\n");
+    failures++;
+  }
+#endif
+
+  free(bounds);
+  free(offsets);
+
+  return failures > 0;
+}
+
+static void
+runBlockBoundsTests(void **state, zfp_mode mode)
+{
+  struct setupVars *bundle = *state;
+
+  int failures = 0;
+  int compressParam;
+  for (compressParam = 0; compressParam < (mode == zfp_mode_reversible ? 1 : 3); compressParam++) {
+    if (setupCompressParam(bundle, mode, compressParam) == 1) {
+      failures++;
+      continue;
+    }
+
+    failures += isBlockBoundsBoundingBlockValues(bundle, mode);
+
+    zfp_stream_rewind(bundle->stream);
+    memset(bundle->buffer, 0, bundle->bufsizeBytes);
+  }
+
+  if (failures > 0) {
+    fail_msg("Block bounds test failure\n");
+  }
+}
+
+static void
+_catFunc3(given_, DESCRIPTOR, Array_when_ZfpStreamBlockBoundsFixedRate_expect_BoundsMatchBlockMaxima)(void **state)
+{
+  runBlockBoundsTests(state, zfp_mode_fixed_rate);
+}
+
+static void
+_catFunc3(given_, DESCRIPTOR, Array_when_ZfpStreamBlockBoundsFixedPrecision_expect_BoundsMatchBlockMaxima)(void **state)
+{
+  runBlockBoundsTests(state, zfp_mode_fixed_precision);
+}
+
+static void
+_catFunc3(given_, DESCRIPTOR, Array_when_ZfpStreamBlockBoundsReversible_expect_BoundsMatchBlockMaxima)(void **state)
+{
+  runBlockBoundsTests(state, zfp_mode_reversible);
+}
+
+// returns 0 on success, 1 on test failure
+static int
+isComponentsDecompressedArrayMatchingStridedArray(struct setupVars* bundle)
+{
+  const uint nc = 3;
+  size_t n = bundle->totalRandomGenArrLen;
+  size_t i;
+  uint c;
+
+  // interleave three distinct permutations of the random array
+  Scalar* aosArr = malloc(nc * n * sizeof(Scalar));
+  Scalar* outArr = calloc(nc * n, sizeof(Scalar));
+  Scalar* refArr = calloc(nc * n, sizeof(Scalar));
+  assert_non_null(aosArr);
+  assert_non_null(outArr);
+  assert_non_null(refArr);
+  for (i = 0; i < n; i++) {
+    aosArr[nc * i + 0] = bundle->randomGenArr[i];
+    aosArr[nc * i + 1] = bundle->randomGenArr[n - 1 - i];
+    aosArr[nc * i + 2] = bundle->randomGenArr[(i + n / 2) % n];
+  }
+
+  zfp_field field = *bundle->field;
+  zfp_field_set_stride_4d(&field, 0, 0, 0, 0);
+  zfp_field_set_pointer(&field, aosArr);
+  assert_int_equal(zfp_field_set_components(&field, nc), nc);
+  assert_int_equal(zfp_field_size(&field, NULL), nc * n);
+  assert_true(zfp_field_is_contiguous(&field));
+
+  // use separate stream large enough to hold all components
+  zfp_stream* stream = bundle->stream;
+  bitstream* origStream = zfp_stream_bit_stream(stream);
+  size_t bufsizeBytes = zfp_stream_maximum_size(stream, &field);
+  void* buffer = malloc(bufsizeBytes);
+  assert_non_null(buffer);
+  bitstream* s = stream_open(buffer, bufsizeBytes);
+  zfp_stream_set_bit_stream(stream, s);
+
+  int failures = 0;
+  size_t compressedBytes = zfp_compress(stream, &field);
+  zfp_stream_rewind(stream);
+  zfp_field_set_pointer(&field, outArr);
+  if (compressedBytes == 0 || zfp_decompress(stream, &field) != compressedBytes) {
+    printf("Compression of interleaved components failed\n");
+    failures++;
+  }
+
+  // each component decompresses as if it were compressed on its own
+  ptrdiff_t stride[4] = { 0, 0, 0, 0 };
+  zfp_field_stride(&field, stride);
+  zfp_field component = field;
+  zfp_field_set_components(&component, 1);
+  zfp_field_set_stride_4d(&component, stride[0], stride[1], stride[2], stride[3]);
+  for (c = 0; c < nc; c++) {
+    zfp_stream_rewind(stream);
+    zfp_field_set_pointer(&component, aosArr + c);
+    zfp_compress(stream, &component);
+    zfp_stream_rewind(stream);
+    zfp_field_set_pointer(&component, refArr + c);
+    zfp_decompress(stream, &component);
+  }
+  if (!failures && memcmp(outArr, refArr, nc * n * sizeof(Scalar))) {
+    printf("Interleaved components differ from separately compressed components\n");
+    failures++;
+  }
+
+  zfp_stream_set_bit_stream(stream, origStream);
+  stream_close(s);
+  free(buffer);
+  free(aosArr);
+  free(outArr);
+  free(refArr);
+
+  return failures > 0;
+}
+
+static void
+runComponentsTests(void **state, zfp_mode mode)
+{
+  struct setupVars *bundle = *state;
+
+  int failures = 0;
+  int compressParam;
+  for (compressParam = 0; compressParam < 3; compressParam++) {
+    if (setupCompressParam(bundle, mode, compressParam) == 1) {
+      failures++;
+      continue;
+    }
+
+    failures += isComponentsDecompressedArrayMatchingStridedArray(bundle);
+  }
+
+  if (failures > 0) {
+    fail_msg("Interleaved components test failure\n");
+  }
+}
+
+static void
+_catFunc3(given_, DESCRIPTOR, InterleavedComponents_when_ZfpCompressDecompressFixedRate_expect_ComponentsMatchStridedCompression)(void **state)
+{
+  runComponentsTests(state, zfp_mode_fixed_rate);
+}
+
+static void
+_catFunc3(given_, DESCRIPTOR, InterleavedComponents_when_ZfpCompressDecompressFixedPrecision_expect_ComponentsMatchStridedCompression)(void **state)
+{
+  runComponentsTests(state, zfp_mode_fixed_precision);
+}
+
 // setup functions
 static int
 setupPermuted(void **state)
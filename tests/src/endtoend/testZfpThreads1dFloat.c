@@ -0,0 +1,13 @@
+#include "src/encode1f.c"
+
+#include "constants/1dFloat.h"
+#include "threadsExecBase.c"
+
+int main()
+{
+  const struct CMUnitTest tests[] = {
+    #include "testcases/threads.c"
+  };
+
+  return cmocka_run_group_tests(tests, setupRandomData, teardownRandomData);
+}
@@ -0,0 +1,13 @@
+#include "src/encode1l.c"
+
+#include "constants/1dInt64.h"
+#include "threadsExecBase.c"
+
+int main()
+{
+  const struct CMUnitTest tests[] = {
+    #include "testcases/threads.c"
+  };
+
+  return cmocka_run_group_tests(tests, setupRandomData, teardownRandomData);
+}
@@ -0,0 +1,13 @@
+#include "src/encode2l.c"
+
+#include "constants/2dInt64.h"
+#include "threadsExecBase.c"
+
+int main()
+{
+  const struct CMUnitTest tests[] = {
+    #include "testcases/threads.c"
+  };
+
+  return cmocka_run_group_tests(tests, setupRandomData, teardownRandomData);
+}
@@ -2,7 +2,7 @@
 
 _cmocka_unit_test(when_seededRandomSmoothDataGenerated_expect_ChecksumMatches),
 
-// OpenMP decompression not yet supported
+// OpenMP decompression supported only in fixed-rate mode or with a chunk index
 
 /* strided tests */
 _cmocka_unit_test_setup_teardown(_catFunc3(given_OpenMP_, DIM_INT_STR, ReversedArray_when_ZfpCompressFixedPrecision_expect_BitstreamChecksumsMatch), setupReversed, teardown),
@@ -18,3 +18,13 @@ _cmocka_unit_test_setup_teardown(_catFunc3(given_OpenMP_, DIM_INT_STR, Array_whe
 _cmocka_unit_test_setup_teardown(_catFunc3(given_OpenMP_, DIM_INT_STR, Array_when_ZfpCompressFixedAccuracy_expect_BitstreamChecksumsMatch), setupDefaultStride, teardown),
 #endif
 _cmocka_unit_test_setup_teardown(_catFunc3(given_OpenMP_, DIM_INT_STR, Array_when_ZfpCompressReversible_expect_BitstreamChecksumsMatch), setupDefaultStride, teardown),
+
+/* chunk index tests */
+_cmocka_unit_test_setup_teardown(_catFunc3(given_OpenMP_, DIM_INT_STR, Array_when_ZfpDecompressFixedPrecisionWithChunkIndex_expect_ArrayChecksumsMatch), setupDefaultStride, teardown),
+#ifdef FL_PT_DATA
+_cmocka_unit_test_setup_teardown(_catFunc3(given_OpenMP_, DIM_INT_STR, Array_when_ZfpDecompressFixedAccuracyWithChunkIndex_expect_ArrayChecksumsMatch), setupDefaultStride, teardown),
+#endif
+_cmocka_unit_test_setup_teardown(_catFunc3(given_OpenMP_, DIM_INT_STR, Array_when_ZfpDecompressCorruptChunkIndex_expect_Failure), setupDefaultStride, teardown),
+
+/* callback stream tests */
+_cmocka_unit_test_setup_teardown(_catFunc3(given_OpenMP_, DIM_INT_STR, Array_when_ZfpCompressOrDecompressCallbackStream_expect_Failure), setupDefaultStride, teardown),
@@ -29,3 +29,32 @@ _cmocka_unit_test_setup_teardown(_catFunc3(given_, DIM_INT_STR, Array_when_ZfpCo
 
 /* reversible */
 _cmocka_unit_test_setup_teardown(_catFunc3(given_, DIM_INT_STR, Array_when_ZfpCompressDecompressReversible_expect_BitstreamAndArrayChecksumsMatch), setupDefaultStride, teardown),
+
+/* box decompression */
+_cmocka_unit_test_setup_teardown(_catFunc3(given_, DIM_INT_STR, Array_when_ZfpDecompressBoxFixedRate_expect_BoxMatchesDecompressedArray), setupDefaultStride, teardown),
+_cmocka_unit_test_setup_teardown(_catFunc3(given_, DIM_INT_STR, Array_when_ZfpDecompressBoxFixedPrecision_expect_BoxMatchesDecompressedArray), setupDefaultStride, teardown),
+_cmocka_unit_test_setup_teardown(_catFunc3(given_, DIM_INT_STR, Array_when_ZfpDecompressCorruptChunkCount_expect_Failure), setupDefaultStride, teardown),
+_cmocka_unit_test_setup_teardown(_catFunc3(given_, DIM_INT_STR, Array_when_ZfpDecompressBoxCorruptChunkIndex_expect_Failure), setupDefaultStride, teardown),
+_cmocka_unit_test_setup_teardown(_catFunc3(given_, DIM_INT_STR, SourceStream_when_ZfpDecompressBox_expect_Failure), setupDefaultStride, teardown),
+
+/* slab compression */
+_cmocka_unit_test_setup_teardown(_catFunc3(given_, DIM_INT_STR, Array_when_ZfpCompressSlabFixedRate_expect_StreamMatchesZfpCompress), setupDefaultStride, teardown),
+_cmocka_unit_test_setup_teardown(_catFunc3(given_, DIM_INT_STR, Array_when_ZfpCompressSlabFixedPrecision_expect_StreamMatchesZfpCompress), setupDefaultStride, teardown),
+_cmocka_unit_test_setup_teardown(_catFunc3(given_, DIM_INT_STR, Array_when_ZfpCompressSlabToSinkStream_expect_SinkReceivesZfpCompressStream), setupDefaultStride, teardown),
+
+/* slab decompression */
+_cmocka_unit_test_setup_teardown(_catFunc3(given_, DIM_INT_STR, Array_when_ZfpDecompressSlabFixedRate_expect_SlabsMatchDecompressedArray), setupDefaultStride, teardown),
+_cmocka_unit_test_setup_teardown(_catFunc3(given_, DIM_INT_STR, Array_when_ZfpDecompressSlabFixedPrecision_expect_SlabsMatchDecompressedArray), setupDefaultStride, teardown),
+
+/* size estimation */
+_cmocka_unit_test_setup_teardown(_catFunc3(given_, DIM_INT_STR, Array_when_ZfpStreamEstimateSizeFixedRate_expect_EstimateMatchesCompressedSize), setupDefaultStride, teardown),
+_cmocka_unit_test_setup_teardown(_catFunc3(given_, DIM_INT_STR, Array_when_ZfpStreamEstimateSizeFixedPrecision_expect_EstimateMatchesCompressedSize), setupDefaultStride, teardown),
+
+/* block bounds */
+_cmocka_unit_test_setup_teardown(_catFunc3(given_, DIM_INT_STR, Array_when_ZfpStreamBlockBoundsFixedRate_expect_BoundsMatchBlockMaxima), setupDefaultStride, teardown),
+_cmocka_unit_test_setup_teardown(_catFunc3(given_, DIM_INT_STR, Array_when_ZfpStreamBlockBoundsFixedPrecision_expect_BoundsMatchBlockMaxima), setupDefaultStride, teardown),
+_cmocka_unit_test_setup_teardown(_catFunc3(given_, DIM_INT_STR, Array_when_ZfpStreamBlockBoundsReversible_expect_BoundsMatchBlockMaxima), setupDefaultStride, teardown),
+
+/* interleaved components */
+_cmocka_unit_test_setup_teardown(_catFunc3(given_, DIM_INT_STR, InterleavedComponents_when_ZfpCompressDecompressFixedRate_expect_ComponentsMatchStridedCompression), setupDefaultStride, teardown),
+_cmocka_unit_test_setup_teardown(_catFunc3(given_, DIM_INT_STR, InterleavedComponents_when_ZfpCompressDecompressFixedPrecision_expect_ComponentsMatchStridedCompression), setupDefaultStride, teardown),
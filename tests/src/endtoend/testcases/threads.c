@@ -0,0 +1,30 @@
+// requires #include "utils/testMacros.h", do outside of main()
+
+_cmocka_unit_test(when_seededRandomSmoothDataGenerated_expect_ChecksumMatches),
+
+// native threads decompression supported only in fixed-rate mode or with a chunk index
+
+/* strided tests */
+_cmocka_unit_test_setup_teardown(_catFunc3(given_Threads_, DIM_INT_STR, ReversedArray_when_ZfpCompressFixedPrecision_expect_BitstreamChecksumsMatch), setupReversed, teardown),
+_cmocka_unit_test_setup_teardown(_catFunc3(given_Threads_, DIM_INT_STR, InterleavedArray_when_ZfpCompressFixedPrecision_expect_BitstreamChecksumsMatch), setupInterleaved, teardown),
+#if DIMS >= 2
+_cmocka_unit_test_setup_teardown(_catFunc3(given_Threads_, DIM_INT_STR, PermutedArray_when_ZfpCompressFixedPrecision_expect_BitstreamChecksumsMatch), setupPermuted, teardown),
+#endif
+
+/* non-strided tests */
+_cmocka_unit_test_setup_teardown(_catFunc3(given_Threads_, DIM_INT_STR, Array_when_ZfpCompressFixedPrecision_expect_BitstreamChecksumsMatch), setupDefaultStride, teardown),
+_cmocka_unit_test_setup_teardown(_catFunc3(given_Threads_, DIM_INT_STR, Array_when_ZfpCompressFixedRate_expect_BitstreamChecksumsMatch), setupDefaultStride, teardown),
+#ifdef FL_PT_DATA
+_cmocka_unit_test_setup_teardown(_catFunc3(given_Threads_, DIM_INT_STR, Array_when_ZfpCompressFixedAccuracy_expect_BitstreamChecksumsMatch), setupDefaultStride, teardown),
+#endif
+_cmocka_unit_test_setup_teardown(_catFunc3(given_Threads_, DIM_INT_STR, Array_when_ZfpCompressReversible_expect_BitstreamChecksumsMatch), setupDefaultStride, teardown),
+
+/* chunk index tests */
+_cmocka_unit_test_setup_teardown(_catFunc3(given_Threads_, DIM_INT_STR, Array_when_ZfpDecompressFixedPrecisionWithChunkIndex_expect_ArrayChecksumsMatch), setupDefaultStride, teardown),
+#ifdef FL_PT_DATA
+_cmocka_unit_test_setup_teardown(_catFunc3(given_Threads_, DIM_INT_STR, Array_when_ZfpDecompressFixedAccuracyWithChunkIndex_expect_ArrayChecksumsMatch), setupDefaultStride, teardown),
+#endif
+_cmocka_unit_test_setup_teardown(_catFunc3(given_Threads_, DIM_INT_STR, Array_when_ZfpDecompressCorruptChunkIndex_expect_Failure), setupDefaultStride, teardown),
+
+/* callback stream tests */
+_cmocka_unit_test_setup_teardown(_catFunc3(given_Threads_, DIM_INT_STR, Array_when_ZfpCompressOrDecompressCallbackStream_expect_Failure), setupDefaultStride, teardown),
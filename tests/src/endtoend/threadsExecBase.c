@@ -0,0 +1,373 @@
+#ifdef ZFP_WITH_THREADS
+
+#include <math.h>
+#include <unistd.h>
+
+#define PREPEND_THREADS(x) Threads_ ## x
+#define DESCRIPTOR_INTERMEDIATE(x) PREPEND_THREADS(x)
+#define DESCRIPTOR DESCRIPTOR_INTERMEDIATE(DIM_INT_STR)
+
+#define ZFP_TEST_THREADS
+#include "zfpEndtoendBase.c"
+
+static size_t
+computeTotalBlocks(zfp_field* field)
+{
+  size_t bx = 1;
+  size_t by = 1;
+  size_t bz = 1;
+  size_t bw = 1;
+  switch (zfp_field_dimensionality(field)) {
+    case 4:
+      bw = (field->nw + 3) / 4;
+    case 3:
+      bz = (field->nz + 3) / 4;
+    case 2:
+      by = (field->ny + 3) / 4;
+    case 1:
+      bx = (field->nx + 3) / 4;
+      return bx * by * bz * bw;
+  }
+
+  return 0;
+}
+
+/* returns actual chunk size (in blocks), not the parameter stored (zero implies failure) */
+static uint
+setChunkSize(void **state, uint threadCount, int param)
+{
+  struct setupVars *bundle = *state;
+  zfp_stream* stream = bundle->stream;
+
+  uint chunk_size = 0;
+  switch (param) {
+    case 2:
+      // largest chunk size: total num blocks
+      chunk_size = (uint)computeTotalBlocks(bundle->field);
+      break;
+
+    case 1:
+      // smallest chunk size: 1 block
+      chunk_size = 1u;
+      break;
+
+    case 0:
+      // default chunk size (0 implies 1 chunk per thread)
+      chunk_size = (uint)((computeTotalBlocks(bundle->field) + threadCount - 1) / threadCount);
+      break;
+
+    default:
+      printf("Unsupported chunkParam\n");
+      return 0;
+  }
+
+  if (chunk_size == 0) {
+    printf("Chunk size was computed to be 0 blocks\n");
+    return 0;
+  } else if (zfp_stream_set_thread_chunk_size(stream, chunk_size) == 0) {
+    printf("zfp_stream_set_thread_chunk_size(stream, %u) failed (returned 0)\n", chunk_size);
+    return 0;
+  }
+
+  return chunk_size;
+}
+
+static uint
+setThreadCount(struct setupVars *bundle, int param)
+{
+  zfp_stream* stream = bundle->stream;
+
+  uint threadParam = (uint)param;
+  uint actualThreadCount = threadParam ? threadParam : (uint)sysconf(_SC_NPROCESSORS_ONLN);
+
+  if (zfp_stream_set_thread_count(stream, threadParam) == 0) {
+    return 0;
+  } else {
+    return actualThreadCount;
+  }
+}
+
+// native threads endtoend entry functions
+// decompression is supported only in fixed-rate mode or with a chunk index
+// loop across 3 compression parameters
+
+// returns 0 on success, 1 on test failure
+static int
+runCompressAcrossThreadsChunks(void **state, zfp_mode mode)
+{
+  struct setupVars *bundle = *state;
+
+  int failures = 0;
+  int threadParam, chunkParam;
+  // run across 3 thread counts
+  for (threadParam = 0; threadParam < 3; threadParam++) {
+    uint threadCount = setThreadCount(bundle, threadParam);
+    if (threadCount == 0) {
+      printf("Threadcount was 0\n");
+      failures += 3;
+      continue;
+    } else {
+      printf("\t\tThread count: %u\n", threadCount);
+    }
+
+    for (chunkParam = 0; chunkParam < 3; chunkParam++) {
+      uint chunkSize = setChunkSize(state, threadCount, chunkParam);
+      if (chunkSize == 0) {
+        printf("ERROR: Computed chunk size was 0 blocks\n");
+        failures++;
+        continue;
+      } else {
+        printf("\t\t\tChunk size: %u blocks\n", chunkSize);
+      }
+
+      int numCompressParams = (mode == zfp_mode_reversible) ? 1 : 3;
+      int doDecompress = (mode == zfp_mode_fixed_rate);
+      failures += runCompressDecompressAcrossParamsGivenMode(state, doDecompress, mode, numCompressParams);
+    }
+  }
+
+  if (failures > 0) {
+    fail_msg("Overall compress/decompress test failure\n");
+  }
+
+  return failures > 0;
+}
+
+// chunk index alters compressed bitstream, so only decompressed arrays are checked
+// returns 0 on success, 1 on test failure
+static int
+runChunkIndexAcrossThreadsChunks(void **state, zfp_mode mode)
+{
+  struct setupVars *bundle = *state;
+  zfp_stream* stream = bundle->stream;
+
+  int failures = 0;
+  int threadParam, chunkParam, compressParam;
+  zfp_stream_set_chunk_index(stream, zfp_true);
+
+  // run across 3 thread counts
+  for (threadParam = 0; threadParam < 3; threadParam++) {
+    uint threadCount = setThreadCount(bundle, threadParam);
+    if (threadCount == 0) {
+      printf("Threadcount was 0\n");
+      failures += 3;
+      continue;
+    } else {
+      printf("\t\tThread count: %u\n", threadCount);
+    }
+
+    for (chunkParam = 0; chunkParam < 3; chunkParam++) {
+      uint chunkSize = setChunkSize(state, threadCount, chunkParam);
+      if (chunkSize == 0) {
+        printf("ERROR: Computed chunk size was 0 blocks\n");
+        failures++;
+        continue;
+      } else {
+        printf("\t\t\tChunk size: %u blocks\n", chunkSize);
+      }
+
+      for (compressParam = 0; compressParam < 3; compressParam++) {
+        size_t compressedBytes;
+        if (setupCompressParam(bundle, mode, compressParam) == 1 ||
+            runZfpCompress(stream, bundle->field, bundle->timer, &compressedBytes) == 1) {
+          failures++;
+          continue;
+        }
+
+        zfp_stream_rewind(stream);
+        if (runZfpDecompress(stream, bundle->decompressField, bundle->timer, compressedBytes) == 1 ||
+            isDecompressedArrayChecksumsMatch(bundle) == 1) {
+          failures++;
+        }
+
+        zfp_stream_rewind(stream);
+        memset(bundle->buffer, 0, bundle->bufsizeBytes);
+      }
+    }
+  }
+
+  if (failures > 0) {
+    fail_msg("Overall chunk index compress/decompress test failure\n");
+  }
+
+  return failures > 0;
+}
+
+static void
+_catFunc3(given_, DESCRIPTOR, Array_when_ZfpCompressFixedPrecision_expect_BitstreamChecksumsMatch)(void **state)
+{
+  runCompressAcrossThreadsChunks(state, zfp_mode_fixed_precision);
+}
+
+static void
+_catFunc3(given_, DESCRIPTOR, Array_when_ZfpCompressFixedRate_expect_BitstreamChecksumsMatch)(void **state)
+{
+  runCompressAcrossThreadsChunks(state, zfp_mode_fixed_rate);
+}
+
+#ifdef FL_PT_DATA
+static void
+_catFunc3(given_, DESCRIPTOR, Array_when_ZfpCompressFixedAccuracy_expect_BitstreamChecksumsMatch)(void **state)
+{
+  runCompressAcrossThreadsChunks(state, zfp_mode_fixed_accuracy);
+}
+#endif
+
+static void
+_catFunc3(given_, DESCRIPTOR, Array_when_ZfpCompressReversible_expect_BitstreamChecksumsMatch)(void **state)
+{
+  runCompressAcrossThreadsChunks(state, zfp_mode_reversible);
+}
+
+static void
+_catFunc3(given_, DESCRIPTOR, Array_when_ZfpDecompressFixedPrecisionWithChunkIndex_expect_ArrayChecksumsMatch)(void **state)
+{
+  runChunkIndexAcrossThreadsChunks(state, zfp_mode_fixed_precision);
+}
+
+#ifdef FL_PT_DATA
+static void
+_catFunc3(given_, DESCRIPTOR, Array_when_ZfpDecompressFixedAccuracyWithChunkIndex_expect_ArrayChecksumsMatch)(void **state)
+{
+  runChunkIndexAcrossThreadsChunks(state, zfp_mode_fixed_accuracy);
+}
+#endif
+
+static void
+_catFunc3(given_, DESCRIPTOR, Array_when_ZfpDecompressCorruptChunkIndex_expect_Failure)(void **state)
+{
+  struct setupVars *bundle = *state;
+  zfp_stream* stream = bundle->stream;
+  uint64* index = (uint64*)bundle->buffer;
+  size_t compressedBytes;
+  zfp_stream_set_chunk_index(stream, zfp_true);
+
+  uint threadCount = setThreadCount(bundle, 2);
+  if (threadCount == 0 ||
+      setChunkSize(state, threadCount, 1) == 0 ||
+      setupCompressParam(bundle, zfp_mode_fixed_precision, 1) == 1 ||
+      runZfpCompress(stream, bundle->field, bundle->timer, &compressedBytes) == 1) {
+    fail_msg("Chunk index compression failure\n");
+  }
+
+  // point last chunk past end of stream
+  index[index[0]] = ~(uint64)0;
+
+  zfp_stream_rewind(stream);
+  assert_int_equal(zfp_decompress(stream, bundle->decompressField), 0);
+}
+
+static size_t
+discardSink(const void* data, size_t bytes, void* context)
+{
+  return bytes;
+}
+
+static size_t
+emptySource(void* data, size_t bytes, void* context)
+{
+  return 0;
+}
+
+static void
+_catFunc3(given_, DESCRIPTOR, Array_when_ZfpCompressOrDecompressCallbackStream_expect_Failure)(void **state)
+{
+  struct setupVars *bundle = *state;
+  zfp_stream* stream = bundle->stream;
+  bitstream* memoryStream = zfp_stream_bit_stream(stream);
+  uint64 buffer[8];
+
+  uint threadCount = setThreadCount(bundle, 2);
+  if (threadCount == 0 ||
+      setChunkSize(state, threadCount, 1) == 0 ||
+      setupCompressParam(bundle, zfp_mode_fixed_rate, 1) == 1) {
+    fail_msg("Callback stream setup failure\n");
+  }
+
+  // callback streams do not support the random access that threads need
+  zfp_stream_set_bit_stream(stream, stream_open_sink(buffer, sizeof(buffer), discardSink, NULL));
+  assert_int_equal(zfp_compress(stream, bundle->field), 0);
+  stream_close(zfp_stream_bit_stream(stream));
+
+  zfp_stream_set_bit_stream(stream, stream_open_source(buffer, sizeof(buffer), emptySource, NULL));
+  assert_int_equal(zfp_decompress(stream, bundle->decompressField), 0);
+  stream_close(zfp_stream_bit_stream(stream));
+
+  zfp_stream_set_bit_stream(stream, memoryStream);
+}
+
+static void
+_catFunc3(given_, DESCRIPTOR, ReversedArray_when_ZfpCompressFixedPrecision_expect_BitstreamChecksumsMatch)(void **state)
+{
+  struct setupVars *bundle = *state;
+  if (bundle->stride != REVERSED) {
+    fail_msg("Invalid stride during test");
+  }
+
+  runCompressAcrossThreadsChunks(state, zfp_mode_fixed_precision);
+}
+
+static void
+_catFunc3(given_, DESCRIPTOR, InterleavedArray_when_ZfpCompressFixedPrecision_expect_BitstreamChecksumsMatch)(void **state)
+{
+  struct setupVars *bundle = *state;
+  if (bundle->stride != INTERLEAVED) {
+    fail_msg("Invalid stride during test");
+  }
+
+  runCompressAcrossThreadsChunks(state, zfp_mode_fixed_precision);
+}
+
+static void
+_catFunc3(given_, DESCRIPTOR, PermutedArray_when_ZfpCompressFixedPrecision_expect_BitstreamChecksumsMatch)(void **state)
+{
+  struct setupVars *bundle = *state;
+  if (bundle->stride != PERMUTED) {
+    fail_msg("Invalid stride during test");
+  }
+
+  runCompressAcrossThreadsChunks(state, zfp_mode_fixed_precision);
+}
+
+
+/* setup functions (pre-test) */
+
+static int
+setupThreadsConfig(void **state, stride_config stride)
+{
+  int result = initZfpStreamAndField(state, stride);
+
+  struct setupVars *bundle = *state;
+  assert_int_equal(zfp_stream_set_execution(bundle->stream, zfp_exec_threads), 1);
+
+  return result;
+}
+
+/* entry functions */
+
+static int
+setupPermuted(void **state)
+{
+  return setupThreadsConfig(state, PERMUTED);
+}
+
+static int
+setupInterleaved(void **state)
+{
+  return setupThreadsConfig(state, INTERLEAVED);
+}
+
+static int
+setupReversed(void **state)
+{
+  return setupThreadsConfig(state, REVERSED);
+}
+
+static int
+setupDefaultStride(void **state)
+{
+  return setupThreadsConfig(state, AS_IS);
+}
+
+// end #ifdef ZFP_WITH_THREADS
+#endif
@@ -139,7 +139,7 @@ given_withOpenMP_serialExec_when_setOmpChunkSize_expect_setToExecOmp(void **stat
 }
 
 static void
-given_withOpenMP_whenDecompressOmpPolicy_expect_noop(void **state)
+given_withOpenMP_whenDecompressOmpPolicyVariableRate_expect_noop(void **state)
 {
   struct setupVars *bundle = *state;
 
@@ -200,7 +200,7 @@ int main()
     cmocka_unit_test_setup_teardown(given_withOpenMP_when_setOmpChunkSize_expect_set, setup, teardown),
     cmocka_unit_test_setup_teardown(given_withOpenMP_serialExec_when_setOmpChunkSize_expect_setToExecOmp, setup, teardown),
 
-    cmocka_unit_test_setup_teardown(given_withOpenMP_whenDecompressOmpPolicy_expect_noop, setupForCompress, teardownForCompress),
+    cmocka_unit_test_setup_teardown(given_withOpenMP_whenDecompressOmpPolicyVariableRate_expect_noop, setupForCompress, teardownForCompress),
 #else
     cmocka_unit_test_setup_teardown(given_withoutOpenMP_when_setExecutionOmp_expect_unableTo, setup, teardown),
     cmocka_unit_test_setup_teardown(given_withoutOpenMP_when_setOmpParams_expect_unableTo, setup, teardown),
@@ -45,6 +45,183 @@ teardown(void **state)
   return 0;
 }
 
+// memory standing in for file accessed through sink or source callbacks
+struct callbackFile {
+  word data[2 * STREAM_WORD_CAPACITY];
+  size_t size;
+  size_t calls;
+};
+
+static size_t
+sinkToCallbackFile(const void* data, size_t bytes, void* context)
+{
+  struct callbackFile* f = context;
+  memcpy((uchar*)f->data + f->size, data, bytes);
+  f->size += bytes;
+  f->calls++;
+  return bytes;
+}
+
+// sink that runs out of space after consuming STREAM_WORD_CAPACITY words
+static size_t
+sinkToFullCallbackFile(const void* data, size_t bytes, void* context)
+{
+  struct callbackFile* f = context;
+  size_t n = STREAM_WORD_CAPACITY * sizeof(word) - f->size;
+  if (n > bytes)
+    n = bytes;
+  memcpy((uchar*)f->data + f->size, data, n);
+  f->size += n;
+  f->calls++;
+  return n;
+}
+
+static size_t
+sourceFromCallbackFile(void* data, size_t bytes, void* context)
+{
+  struct callbackFile* f = context;
+  size_t n = sizeof(f->data) - f->size;
+  if (n > bytes)
+    n = bytes;
+  memcpy(data, (uchar*)f->data + f->size, n);
+  f->size += n;
+  f->calls++;
+  return n;
+}
+
+static void
+given_SinkBitstream_when_WriteBitsPastBufferEnd_expect_FullBufferDrainedToSink(void **state)
+{
+  struct callbackFile f = {{0}, 0, 0};
+  word buffer[STREAM_WORD_CAPACITY];
+  bitstream* s = stream_open_sink(buffer, sizeof(buffer), sinkToCallbackFile, &f);
+
+  uint i;
+  for (i = 0; i < STREAM_WORD_CAPACITY; i++)
+    stream_write_bits(s, WORD1, wsize);
+
+  assert_int_equal(f.calls, 1);
+  assert_int_equal(f.size, STREAM_WORD_CAPACITY * sizeof(word));
+  assert_ptr_equal(s->ptr, s->begin);
+  assert_int_equal(stream_wtell(s), STREAM_WORD_CAPACITY * wsize);
+
+  stream_write_bits(s, WORD2, wsize);
+  stream_write_bits(s, WORD2, 5);
+  size_t padCount = stream_flush(s);
+
+  assert_int_equal(padCount, wsize - 5);
+  assert_int_equal(f.calls, 2);
+  assert_int_equal(f.size, (STREAM_WORD_CAPACITY + 2) * sizeof(word));
+  assert_int_equal(stream_size(s), f.size);
+  assert_int_equal(f.data[STREAM_WORD_CAPACITY - 1], WORD1);
+  assert_int_equal(f.data[STREAM_WORD_CAPACITY], WORD2);
+  assert_int_equal(f.data[STREAM_WORD_CAPACITY + 1], WORD2 & 0x1f);
+
+  stream_close(s);
+}
+
+static void
+given_SinkBitstream_when_SinkConsumesTooFewBytes_expect_StickyError(void **state)
+{
+  struct callbackFile f = {{0}, 0, 0};
+  word buffer[STREAM_WORD_CAPACITY];
+  bitstream* s = stream_open_sink(buffer, sizeof(buffer), sinkToFullCallbackFile, &f);
+
+  uint i;
+  for (i = 0; i < STREAM_WORD_CAPACITY; i++)
+    stream_write_bits(s, WORD1, wsize);
+  stream_flush(s);
+
+  assert_int_equal(f.calls, 1);
+  assert_int_equal(stream_error(s), 0);
+
+  stream_write_bits(s, WORD2, wsize);
+  stream_flush(s);
+
+  assert_int_equal(f.calls, 2);
+  assert_int_not_equal(stream_error(s), 0);
+
+  // once failed, words are no longer passed to sink
+  stream_write_bits(s, WORD2, wsize);
+  stream_flush(s);
+
+  assert_int_equal(f.calls, 2);
+  assert_int_not_equal(stream_error(s), 0);
+
+  stream_close(s);
+}
+
+static void
+given_SourceBitstream_when_ReadBitsPastBufferEnd_expect_BufferRefilledFromSource(void **state)
+{
+  struct callbackFile f = {{0}, 0, 0};
+  uint i;
+  for (i = 0; i < 2 * STREAM_WORD_CAPACITY; i++)
+    f.data[i] = i & 1 ? WORD2 : WORD1;
+
+  word buffer[STREAM_WORD_CAPACITY];
+  bitstream* s = stream_open_source(buffer, sizeof(buffer), sourceFromCallbackFile, &f);
+  assert_int_equal(f.calls, 1);
+
+  for (i = 0; i < STREAM_WORD_CAPACITY; i++)
+    assert_int_equal(stream_read_bits(s, wsize), i & 1 ? WORD2 : WORD1);
+  assert_int_equal(f.calls, 1);
+
+  stream_read_bits(s, 3);
+  assert_int_equal(f.calls, 2);
+  assert_int_equal(stream_rtell(s), STREAM_WORD_CAPACITY * wsize + 3);
+  assert_int_equal(stream_read_bits(s, wsize - 3), (STREAM_WORD_CAPACITY & 1 ? WORD2 : WORD1) >> 3);
+
+  // reading past end of source yields zero-bits
+  stream_rseek(s, 2 * STREAM_WORD_CAPACITY * wsize);
+  assert_int_equal(stream_read_bits(s, wsize), 0);
+
+  stream_close(s);
+}
+
+static void
+given_SourceBitstream_when_RseekPastBufferEnd_expect_WordAtOffsetRead(void **state)
+{
+  struct callbackFile f = {{0}, 0, 0};
+  uint i;
+  for (i = 0; i < 2 * STREAM_WORD_CAPACITY; i++)
+    f.data[i] = i;
+
+  word buffer[STREAM_WORD_CAPACITY];
+  bitstream* s = stream_open_source(buffer, sizeof(buffer), sourceFromCallbackFile, &f);
+
+  stream_rseek(s, (STREAM_WORD_CAPACITY + 1) * wsize);
+
+  assert_int_equal(stream_rtell(s), (STREAM_WORD_CAPACITY + 1) * wsize);
+  assert_int_equal(stream_read_bits(s, wsize), STREAM_WORD_CAPACITY + 1);
+
+  stream_close(s);
+}
+
+static void
+given_SourceBitstream_when_RseekBeforeBufferStart_expect_ErrorAndPositionUnchanged(void **state)
+{
+  struct callbackFile f = {{0}, 0, 0};
+  uint i;
+  for (i = 0; i < 2 * STREAM_WORD_CAPACITY; i++)
+    f.data[i] = i;
+
+  word buffer[STREAM_WORD_CAPACITY];
+  bitstream* s = stream_open_source(buffer, sizeof(buffer), sourceFromCallbackFile, &f);
+
+  stream_rseek(s, (STREAM_WORD_CAPACITY + 1) * wsize);
+  assert_int_equal(stream_error(s), 0);
+
+  // words preceding the refilled buffer can no longer be read
+  stream_rseek(s, wsize);
+
+  assert_int_not_equal(stream_error(s), 0);
+  assert_int_equal(stream_rtell(s), (STREAM_WORD_CAPACITY + 1) * wsize);
+  assert_int_equal(stream_read_bits(s, wsize), STREAM_WORD_CAPACITY + 1);
+
+  stream_close(s);
+}
+
 static void
 when_StreamCopy_expect_BitsCopiedToDestBitstream(void **state)
 {
@@ -668,6 +845,11 @@ int main()
     cmocka_unit_test_setup_teardown(when_Flush_expect_PaddedWordWrittenToStream, setup, teardown),
     cmocka_unit_test_setup_teardown(when_StreamCopy_expect_BitsCopiedToDestBitstream, setup, teardown),
     cmocka_unit_test_setup_teardown(when_StreamCopy_expect_BitsCopiedToDestBitstream, setup, teardown),
+    cmocka_unit_test(given_SinkBitstream_when_WriteBitsPastBufferEnd_expect_FullBufferDrainedToSink),
+    cmocka_unit_test(given_SinkBitstream_when_SinkConsumesTooFewBytes_expect_StickyError),
+    cmocka_unit_test(given_SourceBitstream_when_ReadBitsPastBufferEnd_expect_BufferRefilledFromSource),
+    cmocka_unit_test(given_SourceBitstream_when_RseekPastBufferEnd_expect_WordAtOffsetRead),
+    cmocka_unit_test(given_SourceBitstream_when_RseekBeforeBufferStart_expect_ErrorAndPositionUnchanged),
   };
 
   return cmocka_run_group_tests(tests, NULL, NULL);
@@ -148,6 +148,21 @@ when_zfpFieldSetMetadataCalled_expect_arrayDimensionsSet(void **state)
   assert_int_equal(field->nz, 0);
 }
 
+static void
+when_zfpFieldSetMetadataCalled_expect_scalarComponentsSet(void **state)
+{
+  struct setupVars *bundle = *state;
+  zfp_field* field = bundle->field;
+  uint64 metadata = zfp_field_metadata(field);
+
+  // metadata does not record interleaved components
+  field->components = 3;
+
+  zfp_field_set_metadata(field, metadata);
+
+  assert_int_equal(field->components, 1);
+}
+
 static void
 when_zfpFieldMetadataCalled_onInvalidSize_expect_ZFP_META_NULL(void **state)
 {
@@ -451,6 +466,28 @@ given_invalidCompressParamsInHeader_when_zfpReadHeaderMode_expect_streamParamsNo
   assertCompressParamsBehaviorWhenReadHeader(state, ZFP_MODE_LONG_BITS, 0);
 }
 
+static void
+when_zfpReadHeaderIndex_expect_properNumBitsRead(void **state)
+{
+  setupAndAssertProperNumBitsRead(state, ZFP_HEADER_INDEX, ZFP_INDEX_BITS, ZFP_INDEX_BITS);
+}
+
+static void
+given_chunkIndexEnabledInHeader_when_zfpReadHeaderIndex_expect_chunkIndexEnabled(void **state)
+{
+  struct setupVars *bundle = *state;
+  zfp_stream* stream = bundle->stream;
+  zfp_stream_set_chunk_index(stream, zfp_true);
+
+  assert_int_equal(zfp_write_header(stream, bundle->field, ZFP_HEADER_INDEX), ZFP_INDEX_BITS);
+  zfp_stream_flush(stream);
+  zfp_stream_rewind(stream);
+
+  zfp_stream_set_chunk_index(stream, zfp_false);
+  assert_int_equal(zfp_read_header(stream, bundle->field, ZFP_HEADER_INDEX), ZFP_INDEX_BITS);
+  assert_true(zfp_stream_chunk_index(stream));
+}
+
 int main()
 {
   const struct CMUnitTest tests[] = {
@@ -461,6 +498,7 @@ int main()
 
     cmocka_unit_test_setup_teardown(when_zfpFieldSetMetadataCalled_expect_scalarTypeSet, setup, teardown),
     cmocka_unit_test_setup_teardown(when_zfpFieldSetMetadataCalled_expect_arrayDimensionsSet, setup, teardown),
+    cmocka_unit_test_setup_teardown(when_zfpFieldSetMetadataCalled_expect_scalarComponentsSet, setup, teardown),
 
     // write header
     cmocka_unit_test_setup_teardown(when_zfpWriteHeaderMagic_expect_numBitsWrittenEqualToZFP_MAGIC_BITS, setup, teardown),
@@ -492,6 +530,9 @@ int main()
     cmocka_unit_test_setup_teardown(given_customCompressParamsAndProperHeader_when_zfpReadHeaderMode_expect_streamParamsSet, setup, teardown),
     cmocka_unit_test_setup_teardown(given_invalidCompressParamsInHeader_when_zfpReadHeaderMode_expect_properNumBitsRead, setup, teardown),
     cmocka_unit_test_setup_teardown(given_invalidCompressParamsInHeader_when_zfpReadHeaderMode_expect_streamParamsNotSet, setup, teardown),
+
+    cmocka_unit_test_setup_teardown(when_zfpReadHeaderIndex_expect_properNumBitsRead, setup, teardown),
+    cmocka_unit_test_setup_teardown(given_chunkIndexEnabledInHeader_when_zfpReadHeaderIndex_expect_chunkIndexEnabled, setup, teardown),
   };
   return cmocka_run_group_tests(tests, NULL, NULL);
 }
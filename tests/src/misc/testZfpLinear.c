@@ -0,0 +1,230 @@
+#include "zfp.h"
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <math.h>
+#include <stdlib.h>
+
+#define NX 19
+#define NY 14
+#define NZ 7
+#define LEN (NX * NY * NZ)
+
+// compressed array together with its stream and decompressed values
+typedef struct {
+  void* buffer;
+  bitstream* bs;
+  zfp_stream* stream;
+  double* values;
+} compressed_array;
+
+// stream in fixed-precision mode with room for LEN values of given type
+static void
+openArray(compressed_array* a, zfp_type type, uint precision)
+{
+  zfp_field* field = zfp_field_3d(NULL, type, NX, NY, NZ);
+  a->stream = zfp_stream_open(NULL);
+  zfp_stream_set_precision(a->stream, precision);
+  size_t bufsize = zfp_stream_maximum_size(a->stream, field);
+  a->buffer = malloc(bufsize);
+  assert_non_null(a->buffer);
+  a->bs = stream_open(a->buffer, bufsize);
+  zfp_stream_set_bit_stream(a->stream, a->bs);
+  a->values = malloc(LEN * sizeof(double));
+  assert_non_null(a->values);
+  zfp_field_free(field);
+}
+
+static void
+closeArray(compressed_array* a)
+{
+  zfp_stream_close(a->stream);
+  stream_close(a->bs);
+  free(a->buffer);
+  free(a->values);
+}
+
+// decompress array from start of its stream into double-precision values
+static void
+decompressArray(compressed_array* a, zfp_type type)
+{
+  void* data = malloc(LEN * zfp_type_size(type));
+  assert_non_null(data);
+  zfp_field* field = zfp_field_3d(data, type, NX, NY, NZ);
+  zfp_stream_rewind(a->stream);
+  assert_int_not_equal(zfp_decompress(a->stream, field), 0);
+  size_t i;
+  for (i = 0; i < LEN; i++)
+    a->values[i] = type == zfp_type_float ? ((float*)data)[i] : ((double*)data)[i];
+  zfp_stream_rewind(a->stream);
+  zfp_field_free(field);
+  free(data);
+}
+
+// compress smooth function with given phase and amplitude
+static void
+compressArray(compressed_array* a, zfp_type type, double phase, double amplitude)
+{
+  void* data = malloc(LEN * zfp_type_size(type));
+  assert_non_null(data);
+  size_t i;
+  for (i = 0; i < LEN; i++) {
+    double v = amplitude * sin(0.01 * i + phase) + 0.1 * (i % 5);
+    if (type == zfp_type_float)
+      ((float*)data)[i] = (float)v;
+    else
+      ((double*)data)[i] = v;
+  }
+  zfp_field* field = zfp_field_3d(data, type, NX, NY, NZ);
+  assert_int_not_equal(zfp_compress(a->stream, field), 0);
+  zfp_field_free(field);
+  free(data);
+  decompressArray(a, type);
+}
+
+// largest difference between arrays relative to largest magnitude of ref
+static double
+relativeError(const double* values, const double* ref)
+{
+  double err = 0;
+  double max = 0;
+  size_t i;
+  for (i = 0; i < LEN; i++) {
+    err = fmax(err, fabs(values[i] - ref[i]));
+    max = fmax(max, fabs(ref[i]));
+  }
+  return err / max;
+}
+
+static void
+runScaleTest(zfp_type type, uint precision, double a, double tolerance)
+{
+  compressed_array x, y;
+  openArray(&x, type, precision);
+  openArray(&y, type, precision);
+  compressArray(&x, type, 0, 100);
+
+  zfp_field* field = zfp_field_3d(NULL, type, NX, NY, NZ);
+  assert_int_not_equal(zfp_stream_scale(y.stream, x.stream, field, a), 0);
+  decompressArray(&y, type);
+
+  size_t i;
+  for (i = 0; i < LEN; i++)
+    x.values[i] *= a;
+  if (tolerance == 0)
+    for (i = 0; i < LEN; i++)
+      assert_true(y.values[i] == x.values[i]);
+  else
+    assert_true(relativeError(y.values, x.values) <= tolerance);
+
+  zfp_field_free(field);
+  closeArray(&x);
+  closeArray(&y);
+}
+
+static void
+runAddTest(zfp_type type, uint precision, double tolerance)
+{
+  compressed_array x, y, z;
+  openArray(&x, type, precision);
+  openArray(&y, type, precision);
+  openArray(&z, type, precision);
+  compressArray(&x, type, 0, 100);
+  compressArray(&y, type, 1, 0.01);
+
+  zfp_field* field = zfp_field_3d(NULL, type, NX, NY, NZ);
+  assert_int_not_equal(zfp_stream_add(z.stream, x.stream, y.stream, field), 0);
+  decompressArray(&z, type);
+
+  size_t i;
+  for (i = 0; i < LEN; i++)
+    x.values[i] += y.values[i];
+  assert_true(relativeError(z.values, x.values) <= tolerance);
+
+  zfp_field_free(field);
+  closeArray(&x);
+  closeArray(&y);
+  closeArray(&z);
+}
+
+static void
+given_floatStream_when_ScaleByPowerOfTwo_expect_ExactlyScaledValues(void **state)
+{
+  runScaleTest(zfp_type_float, 20, -0.25, 0);
+}
+
+static void
+given_doubleStream_when_ScaleByPowerOfTwo_expect_ExactlyScaledValues(void **state)
+{
+  runScaleTest(zfp_type_double, 40, 1024, 0);
+}
+
+static void
+given_floatStream_when_Scale_expect_ScaledValues(void **state)
+{
+  runScaleTest(zfp_type_float, 20, 0.3, 1e-3);
+  runScaleTest(zfp_type_float, 20, -7.1, 1e-3);
+}
+
+static void
+given_doubleStream_when_Scale_expect_ScaledValues(void **state)
+{
+  runScaleTest(zfp_type_double, 40, 0.3, 1e-9);
+  runScaleTest(zfp_type_double, 40, -7.1e-30, 1e-9);
+}
+
+static void
+given_floatStream_when_ScaleByZero_expect_ZeroValues(void **state)
+{
+  runScaleTest(zfp_type_float, 20, 0, 0);
+}
+
+static void
+given_floatStreams_when_Add_expect_SummedValues(void **state)
+{
+  runAddTest(zfp_type_float, 20, 1e-3);
+}
+
+static void
+given_doubleStreams_when_Add_expect_SummedValues(void **state)
+{
+  runAddTest(zfp_type_double, 40, 1e-9);
+}
+
+static void
+given_reversibleOrIntegerStream_when_Scale_expect_Failure(void **state)
+{
+  compressed_array x, y;
+  openArray(&x, zfp_type_float, 20);
+  openArray(&y, zfp_type_float, 20);
+  compressArray(&x, zfp_type_float, 0, 1);
+
+  zfp_field* field = zfp_field_3d(NULL, zfp_type_int32, NX, NY, NZ);
+  assert_int_equal(zfp_stream_scale(y.stream, x.stream, field, 2), 0);
+  zfp_field_set_type(field, zfp_type_float);
+  zfp_stream_set_reversible(y.stream);
+  assert_int_equal(zfp_stream_scale(y.stream, x.stream, field, 2), 0);
+
+  zfp_field_free(field);
+  closeArray(&x);
+  closeArray(&y);
+}
+
+int main()
+{
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test(given_floatStream_when_ScaleByPowerOfTwo_expect_ExactlyScaledValues),
+    cmocka_unit_test(given_doubleStream_when_ScaleByPowerOfTwo_expect_ExactlyScaledValues),
+    cmocka_unit_test(given_floatStream_when_Scale_expect_ScaledValues),
+    cmocka_unit_test(given_doubleStream_when_Scale_expect_ScaledValues),
+    cmocka_unit_test(given_floatStream_when_ScaleByZero_expect_ZeroValues),
+    cmocka_unit_test(given_floatStreams_when_Add_expect_SummedValues),
+    cmocka_unit_test(given_doubleStreams_when_Add_expect_SummedValues),
+    cmocka_unit_test(given_reversibleOrIntegerStream_when_Scale_expect_Failure),
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
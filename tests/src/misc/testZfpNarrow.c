@@ -0,0 +1,530 @@
+#include "zfp.h"
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NX 19
+#define NY 14
+#define NZ 7
+#define LEN (NX * NY * NZ)
+
+#define MIN(x, y) ((y) < (x) ? (y) : (x))
+#define MAX(x, y) ((x) < (y) ? (y) : (x))
+
+// single-precision value of finite half or bfloat16 value
+static float
+widen(uint16 x, zfp_type type)
+{
+  if (type == zfp_type_half) {
+    int e = (x >> 10) & 0x1f;
+    int m = x & 0x3ff;
+    float f = e ? (float)ldexp(0x400 + m, e - 25) : (float)ldexp(m, -24);
+    return (x & 0x8000) ? -f : f;
+  }
+  else {
+    uint32 u = (uint32)x << 16;
+    float f;
+    memcpy(&f, &u, sizeof(f));
+    return f;
+  }
+}
+
+// fill arrays with smooth narrow values and their single-precision equivalents
+static void
+initArrays(uint16* narrow, float* wide, zfp_type type)
+{
+  size_t i;
+  for (i = 0; i < LEN; i++) {
+    double t = 0.01 * i;
+    double v = 100 * sin(t) + 0.1 * (i % 7) - 3;
+    int e;
+    uint16 m;
+    // truncate v to 11 (half) or 8 (bfloat16) significant bits
+    if (type == zfp_type_half) {
+      frexp(v, &e);
+      m = (uint16)(ldexp(fabs(v), 11 - e)) & 0x3ffu;
+      narrow[i] = v == 0 ? 0 : (uint16)((v < 0 ? 0x8000u : 0) | ((e + 14) << 10) | m);
+    }
+    else {
+      float f = (float)v;
+      uint32 u;
+      memcpy(&u, &f, sizeof(u));
+      narrow[i] = (uint16)(u >> 16);
+    }
+    wide[i] = widen(narrow[i], type);
+  }
+}
+
+// compress narrow array and equivalent float array and compare streams
+static void
+runStreamTest(zfp_type type, uint dims, zfp_mode mode)
+{
+  uint16* narrow = malloc(LEN * sizeof(uint16));
+  float* wide = malloc(LEN * sizeof(float));
+  assert_non_null(narrow);
+  assert_non_null(wide);
+  initArrays(narrow, wide, type);
+
+  zfp_field* nfield;
+  zfp_field* wfield;
+  switch (dims) {
+    case 1:
+      nfield = zfp_field_1d(narrow, type, LEN);
+      wfield = zfp_field_1d(wide, zfp_type_float, LEN);
+      break;
+    case 2:
+      nfield = zfp_field_2d(narrow, type, NX, NY * NZ);
+      wfield = zfp_field_2d(wide, zfp_type_float, NX, NY * NZ);
+      break;
+    default:
+      nfield = zfp_field_3d(narrow, type, NX, NY, NZ);
+      wfield = zfp_field_3d(wide, zfp_type_float, NX, NY, NZ);
+      break;
+  }
+
+  zfp_stream* stream = zfp_stream_open(NULL);
+  switch (mode) {
+    case zfp_mode_fixed_rate:
+      zfp_stream_set_rate(stream, 8, type, dims, zfp_false);
+      break;
+    case zfp_mode_fixed_precision:
+      zfp_stream_set_precision(stream, 12);
+      break;
+    case zfp_mode_fixed_accuracy:
+      zfp_stream_set_accuracy(stream, 1e-2);
+      break;
+    default:
+      zfp_stream_set_reversible(stream);
+      break;
+  }
+
+  size_t bufsize = zfp_stream_maximum_size(stream, nfield);
+  assert_int_equal(bufsize, zfp_stream_maximum_size(stream, wfield));
+  void* nbuffer = malloc(bufsize);
+  void* wbuffer = malloc(bufsize);
+  assert_non_null(nbuffer);
+  assert_non_null(wbuffer);
+
+  // narrow values are compressed exactly as their single-precision equivalents
+  bitstream* s = stream_open(wbuffer, bufsize);
+  zfp_stream_set_bit_stream(stream, s);
+  size_t wsize = zfp_compress(stream, wfield);
+  stream_close(s);
+
+  s = stream_open(nbuffer, bufsize);
+  zfp_stream_set_bit_stream(stream, s);
+  size_t nsize = zfp_compress(stream, nfield);
+  assert_int_not_equal(nsize, 0);
+  assert_int_equal(nsize, wsize);
+  assert_memory_equal(nbuffer, wbuffer, nsize);
+
+  // decompress to narrow and float arrays
+  uint16* nout = calloc(LEN, sizeof(uint16));
+  float* wout = calloc(LEN, sizeof(float));
+  assert_non_null(nout);
+  assert_non_null(wout);
+  zfp_field_set_pointer(nfield, nout);
+  zfp_field_set_pointer(wfield, wout);
+  zfp_stream_rewind(stream);
+  assert_int_equal(zfp_decompress(stream, nfield), nsize);
+  zfp_stream_rewind(stream);
+  assert_int_equal(zfp_decompress(stream, wfield), nsize);
+
+  size_t i;
+  if (mode == zfp_mode_reversible)
+    assert_memory_equal(nout, narrow, LEN * sizeof(uint16));
+  else
+    for (i = 0; i < LEN; i++) {
+      // narrowed value is within half an ulp of decompressed float
+      float f = widen(nout[i], type);
+      float ulp = f ? (float)ldexp(1, (type == zfp_type_half ? 1 - 11 : 1 - 8) + ilogb(f)) : 0;
+      assert_true(f == wout[i] || fabs(f - wout[i]) <= 0.5 * ulp);
+    }
+
+  stream_close(s);
+  zfp_field_free(nfield);
+  zfp_field_free(wfield);
+  zfp_stream_close(stream);
+  free(nbuffer);
+  free(wbuffer);
+  free(narrow);
+  free(wide);
+  free(nout);
+  free(wout);
+}
+
+static void
+runStreamTests(zfp_type type)
+{
+  uint dims;
+  for (dims = 1; dims <= 3; dims++) {
+    runStreamTest(type, dims, zfp_mode_fixed_rate);
+    runStreamTest(type, dims, zfp_mode_fixed_precision);
+    runStreamTest(type, dims, zfp_mode_fixed_accuracy);
+    runStreamTest(type, dims, zfp_mode_reversible);
+  }
+}
+
+// integer value of element i of narrow integer array mapped to signed range
+static int32
+narrowValue(const void* p, size_t i, zfp_type type)
+{
+  switch (type) {
+    case zfp_type_uint8:
+      return (int32)((const uint8*)p)[i] - 0x80;
+    case zfp_type_uint16:
+      return (int32)((const uint16*)p)[i] - 0x8000;
+    default:
+      return ((const int16*)p)[i];
+  }
+}
+
+// compress narrow integer array and equivalent promoted int32 array and
+// compare streams
+static void
+runIntStreamTest(zfp_type type, uint dims, zfp_mode mode)
+{
+  uint bits = 8 * (uint)zfp_type_size(type);
+  void* narrow = malloc(LEN * zfp_type_size(type));
+  int32* wide = malloc(LEN * sizeof(int32));
+  assert_non_null(narrow);
+  assert_non_null(wide);
+
+  // fill with smooth values spanning the full range
+  size_t i;
+  for (i = 0; i < LEN; i++) {
+    double v = 0.5 * (1 + sin(0.01 * i)) * ((1 << bits) - 1) - 0.25 * (i % 3);
+    uint32 u = (uint32)MAX(0, v);
+    switch (type) {
+      case zfp_type_uint8:
+        ((uint8*)narrow)[i] = (uint8)u;
+        break;
+      case zfp_type_uint16:
+        ((uint16*)narrow)[i] = (uint16)u;
+        break;
+      default:
+        ((int16*)narrow)[i] = (int16)((int32)u - 0x8000);
+        break;
+    }
+    wide[i] = narrowValue(narrow, i, type) * (1 << (31 - bits));
+  }
+
+  zfp_field* nfield;
+  zfp_field* wfield;
+  switch (dims) {
+    case 1:
+      nfield = zfp_field_1d(narrow, type, LEN);
+      wfield = zfp_field_1d(wide, zfp_type_int32, LEN);
+      break;
+    case 2:
+      nfield = zfp_field_2d(narrow, type, NX, NY * NZ);
+      wfield = zfp_field_2d(wide, zfp_type_int32, NX, NY * NZ);
+      break;
+    default:
+      nfield = zfp_field_3d(narrow, type, NX, NY, NZ);
+      wfield = zfp_field_3d(wide, zfp_type_int32, NX, NY, NZ);
+      break;
+  }
+
+  zfp_stream* stream = zfp_stream_open(NULL);
+  switch (mode) {
+    case zfp_mode_fixed_rate:
+      zfp_stream_set_rate(stream, 4, type, dims, zfp_false);
+      break;
+    case zfp_mode_fixed_precision:
+      zfp_stream_set_precision(stream, 10);
+      break;
+    default:
+      zfp_stream_set_reversible(stream);
+      break;
+  }
+
+  size_t bufsize = zfp_stream_maximum_size(stream, nfield);
+  assert_int_equal(bufsize, zfp_stream_maximum_size(stream, wfield));
+  void* nbuffer = malloc(bufsize);
+  void* wbuffer = malloc(bufsize);
+  assert_non_null(nbuffer);
+  assert_non_null(wbuffer);
+
+  // narrow integers are compressed exactly as their promoted equivalents
+  bitstream* s = stream_open(wbuffer, bufsize);
+  zfp_stream_set_bit_stream(stream, s);
+  size_t wsize = zfp_compress(stream, wfield);
+  stream_close(s);
+
+  s = stream_open(nbuffer, bufsize);
+  zfp_stream_set_bit_stream(stream, s);
+  size_t nsize = zfp_compress(stream, nfield);
+  assert_int_not_equal(nsize, 0);
+  assert_int_equal(nsize, wsize);
+  assert_memory_equal(nbuffer, wbuffer, nsize);
+
+  // decompress to narrow and int32 arrays
+  void* nout = calloc(LEN, zfp_type_size(type));
+  int32* wout = calloc(LEN, sizeof(int32));
+  assert_non_null(nout);
+  assert_non_null(wout);
+  zfp_field_set_pointer(nfield, nout);
+  zfp_field_set_pointer(wfield, wout);
+  zfp_stream_rewind(stream);
+  assert_int_equal(zfp_decompress(stream, nfield), nsize);
+  zfp_stream_rewind(stream);
+  assert_int_equal(zfp_decompress(stream, wfield), nsize);
+
+  if (mode == zfp_mode_reversible)
+    assert_memory_equal(nout, narrow, LEN * zfp_type_size(type));
+  for (i = 0; i < LEN; i++) {
+    // narrowed value is demoted int32 value, saturated to narrow range
+    int32 v = wout[i] >> (31 - bits);
+    v = MAX(-(1 << (bits - 1)), MIN(v, (1 << (bits - 1)) - 1));
+    assert_int_equal(narrowValue(nout, i, type), v);
+  }
+
+  stream_close(s);
+  zfp_field_free(nfield);
+  zfp_field_free(wfield);
+  zfp_stream_close(stream);
+  free(nbuffer);
+  free(wbuffer);
+  free(narrow);
+  free(wide);
+  free(nout);
+  free(wout);
+}
+
+static void
+runIntStreamTests(zfp_type type)
+{
+  uint dims;
+  for (dims = 1; dims <= 3; dims++) {
+    runIntStreamTest(type, dims, zfp_mode_fixed_rate);
+    runIntStreamTest(type, dims, zfp_mode_fixed_precision);
+    runIntStreamTest(type, dims, zfp_mode_reversible);
+  }
+}
+
+// compress array of one precision and decompress to the other precision
+// via header, comparing against decompression to the original precision
+static void
+runConversionTest(zfp_type type, zfp_type ctype, zfp_exec_policy exec)
+{
+  size_t size = zfp_type_size(type);
+  size_t csize = zfp_type_size(ctype);
+  double* values = malloc(LEN * sizeof(double));
+  void* data = malloc(LEN * csize);
+  void* out = calloc(LEN, size);
+  void* ref = calloc(LEN, csize);
+  assert_non_null(values);
+  assert_non_null(data);
+  assert_non_null(out);
+  assert_non_null(ref);
+
+  size_t i;
+  for (i = 0; i < LEN; i++) {
+    values[i] = 100 * sin(0.01 * i) + 0.1 * (i % 7) - 3;
+    if (ctype == zfp_type_float)
+      ((float*)data)[i] = (float)values[i];
+    else
+      ((double*)data)[i] = values[i];
+  }
+
+  zfp_field* field = zfp_field_3d(data, ctype, NX, NY, NZ);
+  zfp_stream* stream = zfp_stream_open(NULL);
+  zfp_stream_set_precision(stream, 20);
+  zfp_stream_set_chunk_index(stream, zfp_true);
+  size_t bufsize = zfp_stream_maximum_size(stream, field);
+  void* buffer = malloc(bufsize);
+  assert_non_null(buffer);
+  bitstream* s = stream_open(buffer, bufsize);
+  zfp_stream_set_bit_stream(stream, s);
+  zfp_write_header(stream, field, ZFP_HEADER_FULL);
+  size_t zsize = zfp_compress(stream, field);
+  assert_int_not_equal(zsize, 0);
+
+  // reference decompression to compressed type
+  zfp_field_set_pointer(field, ref);
+  zfp_stream_rewind(stream);
+  assert_int_not_equal(zfp_read_header(stream, field, ZFP_HEADER_FULL), 0);
+  assert_int_equal(zfp_decompress(stream, field), zsize);
+
+  // decompression to other type converts each block
+  zfp_field* ofield = zfp_field_alloc();
+  zfp_stream_rewind(stream);
+  assert_int_not_equal(zfp_read_header(stream, ofield, ZFP_HEADER_FULL), 0);
+  assert_int_equal(zfp_field_type(ofield), ctype);
+  zfp_field_set_type(ofield, type);
+  zfp_field_set_pointer(ofield, out);
+  assert_int_equal(zfp_field_compressed_type(ofield), ctype);
+  if (zfp_stream_set_execution(stream, exec)) {
+    assert_int_equal(zfp_decompress(stream, ofield), zsize);
+    for (i = 0; i < LEN; i++)
+      if (type == zfp_type_float)
+        assert_true(((float*)out)[i] == (float)((double*)ref)[i]);
+      else
+        assert_true(((double*)out)[i] == (double)((float*)ref)[i]);
+  }
+
+  // without a matching compressed type, conversion is rejected
+  zfp_field_set_compressed_type(ofield, zfp_type_int32);
+  zfp_stream_rewind(stream);
+  assert_int_equal(zfp_decompress(stream, ofield), 0);
+
+  stream_close(s);
+  zfp_field_free(field);
+  zfp_field_free(ofield);
+  zfp_stream_close(stream);
+  free(buffer);
+  free(values);
+  free(data);
+  free(out);
+  free(ref);
+}
+
+// compress float array as double and compare with stream for double array
+static void
+given_floatArrayWithDoubleCompressedType_when_ZfpCompress_expect_StreamMatchesDoubleArray(void **state)
+{
+  float* narrow = malloc(LEN * sizeof(float));
+  double* wide = malloc(LEN * sizeof(double));
+  assert_non_null(narrow);
+  assert_non_null(wide);
+  size_t i;
+  for (i = 0; i < LEN; i++) {
+    narrow[i] = (float)(100 * sin(0.01 * i));
+    wide[i] = narrow[i];
+  }
+
+  zfp_field* nfield = zfp_field_3d(narrow, zfp_type_float, NX, NY, NZ);
+  zfp_field* wfield = zfp_field_3d(wide, zfp_type_double, NX, NY, NZ);
+  assert_int_equal(zfp_field_set_compressed_type(nfield, zfp_type_double), zfp_type_double);
+  zfp_stream* stream = zfp_stream_open(NULL);
+  zfp_stream_set_precision(stream, 40);
+  size_t bufsize = zfp_stream_maximum_size(stream, nfield);
+  assert_int_equal(bufsize, zfp_stream_maximum_size(stream, wfield));
+  void* nbuffer = malloc(bufsize);
+  void* wbuffer = malloc(bufsize);
+  assert_non_null(nbuffer);
+  assert_non_null(wbuffer);
+
+  bitstream* s = stream_open(wbuffer, bufsize);
+  zfp_stream_set_bit_stream(stream, s);
+  size_t wsize = zfp_compress(stream, wfield);
+  stream_close(s);
+
+  s = stream_open(nbuffer, bufsize);
+  zfp_stream_set_bit_stream(stream, s);
+  size_t nsize = zfp_compress(stream, nfield);
+  assert_int_not_equal(nsize, 0);
+  assert_int_equal(nsize, wsize);
+  assert_memory_equal(nbuffer, wbuffer, nsize);
+
+  stream_close(s);
+  zfp_field_free(nfield);
+  zfp_field_free(wfield);
+  zfp_stream_close(stream);
+  free(nbuffer);
+  free(wbuffer);
+  free(narrow);
+  free(wide);
+}
+
+static void
+given_doubleStream_when_ZfpDecompressToFloat_expect_ValuesRoundedFromDouble(void **state)
+{
+  runConversionTest(zfp_type_float, zfp_type_double, zfp_exec_serial);
+  runConversionTest(zfp_type_float, zfp_type_double, zfp_exec_omp);
+  runConversionTest(zfp_type_float, zfp_type_double, zfp_exec_threads);
+}
+
+static void
+given_floatStream_when_ZfpDecompressToDouble_expect_ValuesWidenedFromFloat(void **state)
+{
+  runConversionTest(zfp_type_double, zfp_type_float, zfp_exec_serial);
+  runConversionTest(zfp_type_double, zfp_type_float, zfp_exec_omp);
+  runConversionTest(zfp_type_double, zfp_type_float, zfp_exec_threads);
+}
+
+static void
+given_halfArray_when_ZfpCompress_expect_StreamMatchesFloatArray(void **state)
+{
+  runStreamTests(zfp_type_half);
+}
+
+static void
+given_bfloat16Array_when_ZfpCompress_expect_StreamMatchesFloatArray(void **state)
+{
+  runStreamTests(zfp_type_bfloat16);
+}
+
+static void
+given_uint8Array_when_ZfpCompress_expect_StreamMatchesPromotedArray(void **state)
+{
+  runIntStreamTests(zfp_type_uint8);
+}
+
+static void
+given_uint16Array_when_ZfpCompress_expect_StreamMatchesPromotedArray(void **state)
+{
+  runIntStreamTests(zfp_type_uint16);
+}
+
+static void
+given_int16Array_when_ZfpCompress_expect_StreamMatchesPromotedArray(void **state)
+{
+  runIntStreamTests(zfp_type_int16);
+}
+
+static void
+given_halfField_when_zfpFieldMetadataCalled_expect_FloatTypeRecorded(void **state)
+{
+  zfp_field* field = zfp_field_2d(NULL, zfp_type_half, NX, NY);
+  zfp_field* meta = zfp_field_alloc();
+
+  assert_int_equal(zfp_type_size(zfp_type_half), 2);
+  assert_int_equal(zfp_type_size(zfp_type_bfloat16), 2);
+  assert_true(zfp_field_set_metadata(meta, zfp_field_metadata(field)));
+  assert_int_equal(zfp_field_type(meta), zfp_type_float);
+
+  zfp_field_free(field);
+  zfp_field_free(meta);
+}
+
+static void
+given_uint8Field_when_zfpFieldMetadataCalled_expect_Int32TypeRecorded(void **state)
+{
+  zfp_field* field = zfp_field_2d(NULL, zfp_type_uint8, NX, NY);
+  zfp_field* meta = zfp_field_alloc();
+
+  assert_int_equal(zfp_type_size(zfp_type_uint8), 1);
+  assert_int_equal(zfp_type_size(zfp_type_uint16), 2);
+  assert_int_equal(zfp_type_size(zfp_type_int16), 2);
+  assert_true(zfp_field_set_metadata(meta, zfp_field_metadata(field)));
+  assert_int_equal(zfp_field_type(meta), zfp_type_int32);
+
+  zfp_field_free(field);
+  zfp_field_free(meta);
+}
+
+int main()
+{
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test(given_halfArray_when_ZfpCompress_expect_StreamMatchesFloatArray),
+    cmocka_unit_test(given_bfloat16Array_when_ZfpCompress_expect_StreamMatchesFloatArray),
+    cmocka_unit_test(given_uint8Array_when_ZfpCompress_expect_StreamMatchesPromotedArray),
+    cmocka_unit_test(given_uint16Array_when_ZfpCompress_expect_StreamMatchesPromotedArray),
+    cmocka_unit_test(given_int16Array_when_ZfpCompress_expect_StreamMatchesPromotedArray),
+    cmocka_unit_test(given_floatArrayWithDoubleCompressedType_when_ZfpCompress_expect_StreamMatchesDoubleArray),
+    cmocka_unit_test(given_doubleStream_when_ZfpDecompressToFloat_expect_ValuesRoundedFromDouble),
+    cmocka_unit_test(given_floatStream_when_ZfpDecompressToDouble_expect_ValuesWidenedFromFloat),
+    cmocka_unit_test(given_halfField_when_zfpFieldMetadataCalled_expect_FloatTypeRecorded),
+    cmocka_unit_test(given_uint8Field_when_zfpFieldMetadataCalled_expect_Int32TypeRecorded),
+  };
+
+  return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -1,3 +1,11 @@
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+  /* expose mmap, posix_madvise, and truncate */
+  #ifndef _POSIX_C_SOURCE
+    #define _POSIX_C_SOURCE 200809L
+  #endif
+  #define WITH_MMAP
+#endif
+
 #include <float.h>
 #include <limits.h>
 #include <math.h>
@@ -7,6 +15,13 @@
 #include "zfp.h"
 #include "zfp/macros.h"
 
+#ifdef WITH_MMAP
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
 /*
 File I/O is done using the following combinations of i, o, s, and z:
 - i   : read uncompressed
@@ -26,6 +41,67 @@ The 7 major tasks to be accomplished are:
 - compute stats:      s
 */
 
+/* byte size of buffer through which compressed files are streamed */
+#define STREAM_BUFFER_SIZE 0x100000
+
+/* write bytes drained from compressed stream to file */
+static size_t
+write_stream(const void* data, size_t bytes, void* file)
+{
+  return fwrite(data, 1, bytes, (FILE*)file);
+}
+
+/* read bytes into compressed stream from file */
+static size_t
+read_stream(void* data, size_t bytes, void* file)
+{
+  return fread(data, 1, bytes, (FILE*)file);
+}
+
+#ifdef WITH_MMAP
+/* map existing file into memory for reading; return NULL upon failure */
+static void*
+map_input(const char* path, size_t* size)
+{
+  struct stat st;
+  void* data;
+  int fd = open(path, O_RDONLY);
+  if (fd < 0)
+    return NULL;
+  if (fstat(fd, &st) || st.st_size <= 0) {
+    close(fd);
+    return NULL;
+  }
+  data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED)
+    return NULL;
+  posix_madvise(data, (size_t)st.st_size, POSIX_MADV_SEQUENTIAL);
+  *size = (size_t)st.st_size;
+  return data;
+}
+
+/* create file of given size and map it into memory for writing */
+static void*
+map_output(const char* path, size_t size)
+{
+  void* data;
+  int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0666);
+  if (fd < 0)
+    return NULL;
+  if (ftruncate(fd, (off_t)size)) {
+    close(fd);
+    return NULL;
+  }
+  data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED)
+    return NULL;
+  posix_madvise(data, size, POSIX_MADV_SEQUENTIAL);
+  return data;
+}
+#endif
+
 /* compute and print reconstruction error */
 static void
 print_error(const void* fin, const void* fout, zfp_type type, size_t n)
@@ -92,6 +168,7 @@ usage()
   fprintf(stderr, "  -i <path> : uncompressed binary input file (\"-\" for stdin)\n");
   fprintf(stderr, "  -o <path> : decompressed binary output file (\"-\" for stdout)\n");
   fprintf(stderr, "  -z <path> : compressed input (w/o -i) or output file (\"-\" for stdin/stdout)\n");
+  fprintf(stderr, "  -m : memory map input and output files instead of reading/writing them\n");
   fprintf(stderr, "Array type and dimensions (needed with -i):\n");
   fprintf(stderr, "  -f : single precision (float type)\n");
   fprintf(stderr, "  -d : double precision (double type)\n");
@@ -112,8 +189,9 @@ usage()
   fprintf(stderr, "      minexp : min bit plane # coded (-1074 for all bit planes)\n");
   fprintf(stderr, "Execution parameters:\n");
   fprintf(stderr, "  -x serial : serial compression (default)\n");
-  fprintf(stderr, "  -x omp[=threads[,chunk_size]] : OpenMP parallel compression\n");
+  fprintf(stderr, "  -x omp[=threads[,chunk_size]] : OpenMP parallel compression (and fixed rate decompression)\n");
   fprintf(stderr, "  -x cuda : CUDA fixed rate parallel compression/decompression\n");
+  fprintf(stderr, "  -x threads[=threads[,chunk_size]] : native parallel compression (and fixed rate decompression)\n");
   fprintf(stderr, "Examples:\n");
   fprintf(stderr, "  -i file : read uncompressed file and compress to memory\n");
   fprintf(stderr, "  -z file : read compressed file and decompress to memory\n");
@@ -128,6 +206,7 @@ usage()
   fprintf(stderr, "  -d -1 1000000 -a 1e-9 : compression of 1M doubles with < 1e-9 max error\n");
   fprintf(stderr, "  -d -1 1000000 -c 64 64 0 -1074 : 4x fixed-rate compression of 1M doubles\n");
   fprintf(stderr, "  -x omp=16,256 : parallel compression with 16 threads, 256-block chunks\n");
+  fprintf(stderr, "  -m -z zfile -o ofile : decompress mapped zfile straight into mapped ofile\n");
   exit(EXIT_FAILURE);
 }
 
@@ -152,6 +231,7 @@ int main(int argc, char* argv[])
   zfp_bool header = zfp_false;
   zfp_bool quiet = zfp_false;
   zfp_bool stats = zfp_false;
+  zfp_bool mapped = zfp_false;
   char* inpath = 0;
   char* zfppath = 0;
   char* outpath = 0;
@@ -165,6 +245,12 @@ int main(int argc, char* argv[])
   zfp_field* field = NULL;
   zfp_stream* zfp = NULL;
   bitstream* stream = NULL;
+  FILE* zfpfile = NULL;
+  void* inmap = NULL;
+  void* zfpmap = NULL;
+  void* outmap = NULL;
+  size_t inmapsize = 0;
+  size_t zfpmapsize = 0;
   void* fi = NULL;
   void* fo = NULL;
   void* buffer = NULL;
@@ -236,6 +322,9 @@ int main(int argc, char* argv[])
           usage();
         inpath = argv[i];
         break;
+      case 'm':
+        mapped = zfp_true;
+        break;
       case 'o':
         if (++i == argc)
           usage();
@@ -292,6 +381,17 @@ int main(int argc, char* argv[])
         }
         else if (!strcmp(argv[i], "cuda"))
           exec = zfp_exec_cuda;
+        else if (sscanf(argv[i], "threads=%u,%u", &threads, &chunk_size) == 2)
+          exec = zfp_exec_threads;
+        else if (sscanf(argv[i], "threads=%u", &threads) == 1) {
+          exec = zfp_exec_threads;
+          chunk_size = 0;
+        }
+        else if (!strcmp(argv[i], "threads")) {
+          exec = zfp_exec_threads;
+          threads = 0;
+          chunk_size = 0;
+        }
         else
           usage();
         break;
@@ -369,11 +469,50 @@ int main(int argc, char* argv[])
     return EXIT_FAILURE;
   }
 
+#ifndef WITH_MMAP
+  if (mapped) {
+    fprintf(stderr, "memory mapped I/O not available\n");
+    return EXIT_FAILURE;
+  }
+#else
+  /* standard input and output cannot be mapped */
+  if (mapped) {
+    if (inpath && strcmp(inpath, "-"))
+      inmap = map_input(inpath, &inmapsize);
+    if (!inpath && zfppath && strcmp(zfppath, "-"))
+      zfpmap = map_input(zfppath, &zfpmapsize);
+    if ((inpath && strcmp(inpath, "-") && !inmap) || (!inpath && zfppath && strcmp(zfppath, "-") && !zfpmap)) {
+      fprintf(stderr, "cannot map input file\n");
+      return EXIT_FAILURE;
+    }
+  }
+#endif
+
   zfp = zfp_stream_open(NULL);
   field = zfp_field_alloc();
 
   /* read uncompressed or compressed file */
-  if (inpath) {
+  if (inmap) {
+    /* compress straight from mapped input file */
+    rawsize = typesize * count;
+    if (inmapsize < rawsize) {
+      fprintf(stderr, "cannot read input file\n");
+      return EXIT_FAILURE;
+    }
+    fi = inmap;
+    zfp_field_set_pointer(field, fi);
+  }
+  else if (zfpmap) {
+    /* decompress straight from mapped compressed file */
+    zfpsize = zfpmapsize;
+    stream = stream_open(zfpmap, zfpmapsize);
+    if (!stream) {
+      fprintf(stderr, "cannot open compressed stream\n");
+      return EXIT_FAILURE;
+    }
+    zfp_stream_set_bit_stream(zfp, stream);
+  }
+  else if (inpath) {
     /* read uncompressed input file */
     FILE* file = !strcmp(inpath, "-") ? stdin : fopen(inpath, "rb");
     if (!file) {
@@ -393,8 +532,29 @@ int main(int argc, char* argv[])
     fclose(file);
     zfp_field_set_pointer(field, fi);
   }
+  else if (exec == zfp_exec_serial) {
+    /* stream compressed input file through bounded buffer */
+    zfpfile = !strcmp(zfppath, "-") ? stdin : fopen(zfppath, "rb");
+    if (!zfpfile) {
+      fprintf(stderr, "cannot open compressed file\n");
+      return EXIT_FAILURE;
+    }
+    bufsize = STREAM_BUFFER_SIZE;
+    buffer = malloc(bufsize);
+    if (!buffer) {
+      fprintf(stderr, "cannot allocate memory\n");
+      return EXIT_FAILURE;
+    }
+    stream = stream_open_source(buffer, bufsize, read_stream, zfpfile);
+    if (!stream) {
+      fprintf(stderr, "cannot open compressed stream\n");
+      return EXIT_FAILURE;
+    }
+    zfp_stream_set_bit_stream(zfp, stream);
+  }
   else {
-    /* read compressed input file in increasingly large chunks */
+    /* read compressed input file in increasingly large chunks, as parallel
+       decompression needs random access */
     FILE* file = !strcmp(zfppath, "-") ? stdin : fopen(zfppath, "rb");
     if (!file) {
       fprintf(stderr, "cannot open compressed file\n");
@@ -487,6 +647,14 @@ int main(int argc, char* argv[])
         return EXIT_FAILURE;
       }
       break;
+    case zfp_exec_threads:
+      if (!zfp_stream_set_execution(zfp, exec) ||
+          !zfp_stream_set_thread_count(zfp, threads) ||
+          !zfp_stream_set_thread_chunk_size(zfp, chunk_size)) {
+        fprintf(stderr, "native thread execution not available\n");
+        return EXIT_FAILURE;
+      }
+      break;
     case zfp_exec_serial:
     default:
       if (!zfp_stream_set_execution(zfp, exec)) {
@@ -498,20 +666,45 @@ int main(int argc, char* argv[])
 
   /* compress input file if provided */
   if (inpath) {
+    /* stream compressed data to file unless it is needed for decompression */
+    zfp_bool streaming = zfppath && !outpath && !stats && exec == zfp_exec_serial && !mapped;
+
     /* allocate buffer for compressed data */
     bufsize = zfp_stream_maximum_size(zfp, field);
     if (!bufsize) {
       fprintf(stderr, "invalid compression parameters\n");
       return EXIT_FAILURE;
     }
-    buffer = malloc(bufsize);
-    if (!buffer) {
-      fprintf(stderr, "cannot allocate memory\n");
-      return EXIT_FAILURE;
+    if (streaming) {
+      zfpfile = !strcmp(zfppath, "-") ? stdout : fopen(zfppath, "wb");
+      if (!zfpfile) {
+        fprintf(stderr, "cannot create compressed file\n");
+        return EXIT_FAILURE;
+      }
+      bufsize = MIN(bufsize, STREAM_BUFFER_SIZE);
+    }
+#ifdef WITH_MMAP
+    if (mapped && zfppath && strcmp(zfppath, "-")) {
+      /* compress straight into compressed file, truncated once done */
+      zfpmap = map_output(zfppath, bufsize);
+      if (!zfpmap) {
+        fprintf(stderr, "cannot map compressed file\n");
+        return EXIT_FAILURE;
+      }
+      zfpmapsize = bufsize;
+    }
+    else
+#endif
+    {
+      buffer = malloc(bufsize);
+      if (!buffer) {
+        fprintf(stderr, "cannot allocate memory\n");
+        return EXIT_FAILURE;
+      }
     }
 
-    /* associate compressed bit stream with memory buffer */
-    stream = stream_open(buffer, bufsize);
+    /* associate compressed bit stream with memory buffer or file */
+    stream = zfpmap ? stream_open(zfpmap, bufsize) : streaming ? stream_open_sink(buffer, bufsize, write_stream, zfpfile) : stream_open(buffer, bufsize);
     if (!stream) {
       fprintf(stderr, "cannot open compressed stream\n");
       return EXIT_FAILURE;
@@ -527,12 +720,19 @@ int main(int argc, char* argv[])
     /* compress data */
     zfpsize = zfp_compress(zfp, field);
     if (zfpsize == 0) {
-      fprintf(stderr, "compression failed\n");
+      fprintf(stderr, stream_error(stream) ? "cannot write compressed file\n" : "compression failed\n");
       return EXIT_FAILURE;
     }
 
     /* optionally write compressed data */
-    if (zfppath) {
+    if (streaming) {
+      /* stdio may defer reporting of write errors until flushed */
+      if (stream_error(stream) || fflush(zfpfile) || ferror(zfpfile)) {
+        fprintf(stderr, "cannot write compressed file\n");
+        return EXIT_FAILURE;
+      }
+    }
+    else if (zfppath && !zfpmap) {
       FILE* file = !strcmp(zfppath, "-") ? stdout : fopen(zfppath, "wb");
       if (!file) {
         fprintf(stderr, "cannot create compressed file\n");
@@ -570,7 +770,21 @@ int main(int argc, char* argv[])
 
     /* allocate memory for decompressed data */
     rawsize = typesize * count;
-    fo = malloc(rawsize);
+#ifdef WITH_MMAP
+    if (mapped && outpath && strcmp(outpath, "-")) {
+      /* decompress straight into output file */
+      outmap = map_output(outpath, rawsize);
+      if (!outmap) {
+        fprintf(stderr, "cannot map output file\n");
+        return EXIT_FAILURE;
+      }
+      fo = outmap;
+    }
+    else
+#endif
+    {
+      fo = malloc(rawsize);
+    }
     if (!fo) {
       fprintf(stderr, "cannot allocate memory\n");
       return EXIT_FAILURE;
@@ -591,9 +805,16 @@ int main(int argc, char* argv[])
         return EXIT_FAILURE;
       }
     }
+    if (zfpfile && !inpath) {
+      if (ferror(zfpfile)) {
+        fprintf(stderr, "cannot read compressed file\n");
+        return EXIT_FAILURE;
+      }
+      zfpsize = zfp_stream_compressed_size(zfp);
+    }
 
     /* optionally write reconstructed data */
-    if (outpath) {
+    if (outpath && !outmap) {
       FILE* file = !strcmp(outpath, "-") ? stdout : fopen(outpath, "wb");
       if (!file) {
         fprintf(stderr, "cannot create output file\n");
@@ -621,6 +842,26 @@ int main(int argc, char* argv[])
   zfp_field_free(field);
   zfp_stream_close(zfp);
   stream_close(stream);
+  if (zfpfile && zfpfile != stdin && zfpfile != stdout)
+    fclose(zfpfile);
+#ifdef WITH_MMAP
+  if (inmap) {
+    munmap(inmap, inmapsize);
+    fi = NULL;
+  }
+  if (zfpmap) {
+    munmap(zfpmap, zfpmapsize);
+    /* discard unused space reserved for compressed file */
+    if (inpath && truncate(zfppath, (off_t)zfpsize)) {
+      fprintf(stderr, "cannot truncate compressed file\n");
+      return EXIT_FAILURE;
+    }
+  }
+  if (outmap) {
+    munmap(outmap, rawsize);
+    fo = NULL;
+  }
+#endif
   free(buffer);
   free(fi);
   free(fo);